@@ -0,0 +1,213 @@
+// Copyright (c) 2025 Bevan Collins
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <windows.h>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include "clipboard_writer.hpp"
+#include "message_handler.hpp"
+
+namespace wndkit {
+
+namespace details {
+
+// streams a clipboard format into a growable, moveable global memory block
+class hglobal_writer : public clipboard_writer {
+public:
+  static constexpr size_t initial_capacity = 4096;
+
+  hglobal_writer() = default;
+
+  hglobal_writer(const hglobal_writer&) = delete;
+  hglobal_writer& operator=(const hglobal_writer&) = delete;
+
+  ~hglobal_writer() override {
+    if (hglobal_) {
+      GlobalUnlock(hglobal_);
+      GlobalFree(hglobal_);
+    }
+  }
+
+  void reserve(size_t size) override {
+    if (size_ + size > capacity_)
+      grow(size_ + size);
+  }
+
+  void write(std::span<const std::byte> bytes) override {
+    if (size_ + bytes.size() > capacity_)
+      grow(std::max(capacity_ * 2, size_ + bytes.size()));
+
+    std::memcpy(data_ + size_, bytes.data(), bytes.size());
+    size_ += bytes.size();
+  }
+
+  // unlocks the block, trims it to the bytes written and hands it to the caller
+  HGLOBAL detach() {
+    if (!hglobal_)
+      grow(1);
+
+    GlobalUnlock(hglobal_);
+    if (capacity_ > size_) {
+      if (auto trimmed = GlobalReAlloc(hglobal_, std::max<size_t>(size_, 1), GMEM_MOVEABLE))
+        hglobal_ = trimmed;
+    }
+
+    data_ = nullptr;
+    capacity_ = size_ = 0;
+    return std::exchange(hglobal_, nullptr);
+  }
+
+private:
+  void grow(size_t capacity) {
+    capacity = std::max(capacity, initial_capacity);
+
+    HGLOBAL hglobal{};
+    if (hglobal_) {
+      GlobalUnlock(hglobal_);
+      hglobal = GlobalReAlloc(hglobal_, capacity, GMEM_MOVEABLE);
+    } else {
+      hglobal = GlobalAlloc(GMEM_MOVEABLE, capacity);
+    }
+
+    if (!hglobal) {
+      auto error = GetLastError();
+      if (hglobal_)
+        data_ = static_cast<std::byte*>(GlobalLock(hglobal_));
+      throw std::system_error(static_cast<int>(error), std::system_category());
+    }
+
+    hglobal_ = hglobal;
+    data_ = static_cast<std::byte*>(GlobalLock(hglobal_));
+    capacity_ = capacity;
+  }
+
+  HGLOBAL hglobal_{};
+  std::byte* data_{};
+  size_t size_{};
+  size_t capacity_{};
+};
+
+}
+
+/*
+   Offers clipboard formats using delayed rendering.
+
+   `publish` takes ownership of the clipboard and advertises every added format without
+   producing any data. A format is only serialized when an application asks for it
+   (WM_RENDERFORMAT), or when the owner window is destroyed while it still owns the
+   clipboard (WM_RENDERALLFORMATS). The renderers, and anything they capture, are released
+   when another application empties the clipboard (WM_DESTROYCLIPBOARD).
+
+   Example:
+     clipboard_.attach(message_handler_);
+
+     clipboard_
+       .add_format(CF_UNICODETEXT, [grid](wndkit::clipboard_writer& writer) {
+         grid->write_tsv(writer);
+         writer.write_null<wchar_t>();
+       })
+       .add_format(L"HTML Format", [grid](wndkit::clipboard_writer& writer) {
+         grid->write_html(writer);
+       })
+       .publish(hwnd);
+*/
+class clipboard_provider {
+public:
+  /*
+     The renderer must be invocable as: renderer(clipboard_writer&)
+  */
+  using renderer = std::function<void(clipboard_writer&)>;
+
+  // registers the clipboard handlers on the owner window's message handler
+  void attach(message_handler& handler) {
+    handler
+      .on_message<WM_RENDERFORMAT>([this](HWND, const renderformat_params& params) {
+        render(params.clipboard_format());
+      })
+      .on_message<WM_RENDERALLFORMATS>([this](HWND hwnd, const auto&) {
+        render_all(hwnd);
+      })
+      .on_message<WM_DESTROYCLIPBOARD>([this](HWND, const auto&) {
+        published_.clear();
+      })
+    ;
+  }
+
+  clipboard_provider& add_format(UINT format, renderer render) {
+    pending_.push_back({format, std::move(render)});
+    return *this;
+  }
+
+  clipboard_provider& add_format(const wchar_t* format_name, renderer render) {
+    auto format = RegisterClipboardFormatW(format_name);
+    if (!format)
+      throw std::system_error(static_cast<int>(GetLastError()), std::system_category());
+
+    return add_format(format, std::move(render));
+  }
+
+  // takes ownership of the clipboard and advertises the added formats
+  void publish(HWND owner) {
+    if (!OpenClipboard(owner))
+      throw std::system_error(static_cast<int>(GetLastError()), std::system_category());
+
+    // emptying the clipboard sends WM_DESTROYCLIPBOARD to the previous owner (which may be us)
+    EmptyClipboard();
+    published_ = std::move(pending_);
+    pending_.clear();
+
+    for (const auto& entry : published_)
+      SetClipboardData(entry.format, nullptr);
+
+    CloseClipboard();
+  }
+
+private:
+  struct format_entry {
+    UINT format;
+    renderer render;
+    bool rendered{};
+  };
+
+  // the clipboard is already open when this is called
+  void render(UINT format) {
+    auto match = std::find_if(published_.begin(), published_.end(), [format](const auto& entry) {
+        return entry.format == format;
+      });
+
+    if (match != published_.end() && !match->rendered) {
+      details::hglobal_writer writer;
+      match->render(writer);
+
+      auto hglobal = writer.detach();
+      if (SetClipboardData(format, hglobal))
+        match->rendered = true;
+      else
+        GlobalFree(hglobal);
+    }
+  }
+
+  void render_all(HWND hwnd) {
+    if (!OpenClipboard(hwnd))
+      return;
+
+    // another application may have taken ownership before the clipboard could be opened
+    if (GetClipboardOwner() == hwnd) {
+      for (const auto& entry : published_)
+        render(entry.format);
+    }
+
+    CloseClipboard();
+  }
+
+  std::vector<format_entry> pending_;
+  std::vector<format_entry> published_;
+};
+
+}
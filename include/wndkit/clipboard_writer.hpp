@@ -0,0 +1,46 @@
+// Copyright (c) 2025 Bevan Collins
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+namespace wndkit {
+
+/*
+   Receives the serialized bytes of one clipboard format as they are produced.
+
+   Renderers write straight into the destination (for the clipboard, the global memory block
+   that is handed to SetClipboardData) instead of building the whole payload first.
+
+   This header has no Win32 dependencies so renderers can be run against other writers,
+   e.g. to benchmark serialization.
+*/
+class clipboard_writer {
+public:
+  virtual ~clipboard_writer() = default;
+
+  // hints that at least `size` more bytes are about to be written
+  virtual void reserve(size_t size) = 0;
+
+  virtual void write(std::span<const std::byte> bytes) = 0;
+
+  void write_text(std::wstring_view text) {
+    write(std::as_bytes(std::span<const wchar_t>(text.data(), text.size())));
+  }
+
+  void write_text(std::string_view text) {
+    write(std::as_bytes(std::span<const char>(text.data(), text.size())));
+  }
+
+  // writes the terminating null that CF_TEXT/CF_UNICODETEXT require
+  template<typename Char>
+  void write_null() {
+    Char null{};
+    write(std::as_bytes(std::span<const Char>(&null, 1)));
+  }
+};
+
+}
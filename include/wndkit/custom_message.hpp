@@ -0,0 +1,153 @@
+// Copyright (c) 2025 Bevan Collins
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <windows.h>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <typeinfo>
+#include "message_params.hpp"
+#include "details/payload_pool.hpp"
+
+namespace wndkit {
+
+/*
+   An owning pointer to a payload allocated from the calling thread's payload pool.
+*/
+template<typename Payload>
+using pooled_ptr = std::unique_ptr<Payload, details::payload_deleter<Payload>>;
+
+template<typename Payload, typename... Args>
+pooled_ptr<Payload> make_pooled(Args&&... args) {
+  static_assert(alignof(Payload) <= alignof(std::max_align_t), "over-aligned payloads are not supported");
+
+  auto p = details::payload_pool::allocate(sizeof(Payload));
+  try {
+    return pooled_ptr<Payload>(new (p) Payload(std::forward<Args>(args)...));
+  } catch (...) {
+    details::payload_pool::deallocate(p);
+    throw;
+  }
+}
+
+namespace details {
+
+// a type naming its message with `static constexpr const wchar_t* message_name`
+template<typename T>
+concept has_message_name = requires {
+  { T::message_name } -> std::convertible_to<std::wstring_view>;
+};
+
+}
+
+template<typename Payload>
+struct custom_message_params : public message_params {
+  Payload& payload() const { return *reinterpret_cast<Payload*>(lparam); }
+};
+
+/*
+   A typed message that carries a pooled payload through PostMessageW.
+
+   The message ID is registered on first use. A `Tag` (or else the `Payload`) with a static
+   `message_name` is registered under that name, which stays the same across builds and
+   modules. Otherwise the name is made from the compiler's name for the message type, so
+   each distinct `custom_message<Payload, Tag>` gets its own ID, but only modules built by
+   the same compiler agree on it. Use a different `Tag` to declare several messages that
+   share a payload type.
+
+   The payload is owned by the message queue while the message is in flight. It is released
+   by the handler registered with `message_handler::on_custom_message`, or reclaimed by the
+   dispatcher when the window is destroyed before the message is delivered. Payload pointers
+   are only meaningful within the posting process.
+
+   Example:
+     using progress_message = wndkit::custom_message<progress>;
+
+     handler.on_custom_message<progress_message>([](HWND hwnd, progress& p) {
+       // handle progress
+     });
+
+     // from any thread
+     progress_message::post(hwnd, 42, L"Copying");
+
+   With a stable name:
+     struct progress {
+       static constexpr const wchar_t* message_name = L"MyApp.Progress";
+       ...
+     };
+*/
+template<typename Payload, typename Tag = void>
+class custom_message {
+public:
+  using payload_type = Payload;
+  using param_type   = custom_message_params<Payload>;
+  using pointer      = pooled_ptr<Payload>;
+
+  static UINT id() {
+    static const UINT id = register_id();
+    return id;
+  }
+
+  /*
+     Posts the message with a payload constructed from `args`.
+     Returns false (and releases the payload) if the message could not be posted,
+     e.g. because the window has already been destroyed.
+  */
+  template<typename... Args>
+  static bool post(HWND hwnd, Args&&... args) {
+    return post_payload(hwnd, make_pooled<Payload>(std::forward<Args>(args)...));
+  }
+
+  static bool post_payload(HWND hwnd, pointer payload) {
+    if (!PostMessageW(hwnd, id(), 0, reinterpret_cast<LPARAM>(payload.get())))
+      return false;
+
+    payload.release(); // now owned by the message queue
+    return true;
+  }
+
+  // takes ownership of the payload carried by a delivered message
+  static pointer take(const message_params& params) {
+    return pointer(reinterpret_cast<Payload*>(params.lparam));
+  }
+
+  // releases the payloads of any messages still queued for a window
+  static void discard_pending(HWND hwnd) {
+    MSG msg;
+    while (PeekMessageW(&msg, hwnd, id(), id(), PM_REMOVE | PM_NOYIELD))
+      take(message_params{msg.wParam, msg.lParam});
+  }
+
+private:
+  static std::wstring message_name() {
+    if constexpr (details::has_message_name<Tag>) {
+      return std::wstring(std::wstring_view(Tag::message_name));
+    } else if constexpr (details::has_message_name<Payload>) {
+      return std::wstring(std::wstring_view(Payload::message_name));
+    } else {
+      // atom names are limited to 255 characters so long type names are hashed
+      std::string type_name = typeid(custom_message).name();
+      if (type_name.size() > 200)
+        type_name = std::to_string(std::hash<std::string>{}(type_name));
+
+      return L"wndkit.custom_message." + std::wstring(type_name.begin(), type_name.end());
+    }
+  }
+
+  static UINT register_id() {
+    auto name = message_name();
+    auto msg = RegisterWindowMessageW(name.c_str());
+    if (!msg)
+      throw std::system_error(static_cast<int>(GetLastError()), std::system_category());
+
+    return msg;
+  }
+};
+
+}
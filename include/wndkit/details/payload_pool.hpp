@@ -0,0 +1,162 @@
+// Copyright (c) 2025 Bevan Collins
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace wndkit::details {
+
+/*
+   A per-thread pool of fixed-size blocks used to carry message payloads between threads.
+
+   Each producer thread allocates from its own pool without locking. A block may be
+   released on any thread: releases on the owning thread go straight back onto the local
+   free list, releases on other threads are pushed onto a lock-free list that the owner
+   takes over in one exchange once its local list runs dry.
+
+   A pool outlives its thread for as long as any of its blocks are still in flight.
+
+   This header has no Win32 dependencies.
+*/
+class payload_pool {
+public:
+  static constexpr size_t block_granularity = 64;
+  static constexpr size_t size_class_count  = 8;
+  static constexpr size_t blocks_per_slab   = 64;
+
+  payload_pool(const payload_pool&) = delete;
+  payload_pool& operator=(const payload_pool&) = delete;
+
+  // the pool owned by the calling thread
+  static payload_pool& local() {
+    thread_local thread_pool pool;
+    return *pool.pool;
+  }
+
+  static void* allocate(size_t size) {
+    return local().allocate_block(size);
+  }
+
+  static void deallocate(void* p) noexcept {
+    if (!p)
+      return;
+
+    auto header = static_cast<block_header*>(p) - 1;
+    auto owner = header->owner;
+    if (!owner) {
+      ::operator delete(header, std::align_val_t{alignof(block_header)});
+      return;
+    }
+
+    if (owner == current()) {
+      header->next = owner->local_free_[header->size_class];
+      owner->local_free_[header->size_class] = header;
+    } else {
+      auto& list = owner->remote_free_[header->size_class];
+      header->next = list.load(std::memory_order_relaxed);
+      while (!list.compare_exchange_weak(header->next, header, std::memory_order_release, std::memory_order_relaxed))
+        ;
+    }
+
+    owner->release();
+  }
+
+private:
+  struct alignas(std::max_align_t) block_header {
+    payload_pool* owner; // nullptr when the block was too large for the pool
+    block_header* next;
+    size_t size_class;
+  };
+
+  static constexpr size_t max_block_size = block_granularity * size_class_count;
+
+  // keeps the calling thread's reference to its pool
+  struct thread_pool {
+    thread_pool() : pool(new payload_pool) {
+      current() = pool;
+    }
+
+    ~thread_pool() {
+      current() = nullptr;
+      pool->release();
+    }
+
+    payload_pool* pool;
+  };
+
+  payload_pool() = default;
+
+  ~payload_pool() {
+    for (auto slab : slabs_)
+      ::operator delete(slab, std::align_val_t{alignof(block_header)});
+  }
+
+  static payload_pool*& current() {
+    thread_local payload_pool* current_{};
+    return current_;
+  }
+
+  void* allocate_block(size_t size) {
+    auto total = sizeof(block_header) + size;
+    if (total > max_block_size) {
+      auto header = static_cast<block_header*>(::operator new(total, std::align_val_t{alignof(block_header)}));
+      header->owner = nullptr;
+      return header + 1;
+    }
+
+    auto size_class = (total - 1) / block_granularity;
+
+    auto& list = local_free_[size_class];
+    if (!list)
+      list = remote_free_[size_class].exchange(nullptr, std::memory_order_acquire);
+    if (!list)
+      grow(size_class);
+
+    auto header = list;
+    list = header->next;
+
+    refs_.fetch_add(1, std::memory_order_relaxed);
+    return header + 1;
+  }
+
+  void grow(size_t size_class) {
+    auto block_size = (size_class + 1) * block_granularity;
+    auto slab = static_cast<std::byte*>(::operator new(block_size * blocks_per_slab, std::align_val_t{alignof(block_header)}));
+    slabs_.push_back(slab);
+
+    for (size_t i = blocks_per_slab; i-- > 0;) {
+      auto header = reinterpret_cast<block_header*>(slab + i * block_size);
+      header->owner = this;
+      header->size_class = size_class;
+      header->next = local_free_[size_class];
+      local_free_[size_class] = header;
+    }
+  }
+
+  void release() noexcept {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      delete this;
+  }
+
+  static_assert(block_granularity % alignof(block_header) == 0);
+
+  std::array<block_header*, size_class_count> local_free_{};
+  std::array<std::atomic<block_header*>, size_class_count> remote_free_{};
+  std::vector<std::byte*> slabs_;
+  std::atomic<size_t> refs_{1}; // the owning thread plus every block in flight
+};
+
+template<typename T>
+struct payload_deleter {
+  void operator()(T* p) const noexcept {
+    p->~T();
+    payload_pool::deallocate(p);
+  }
+};
+
+}
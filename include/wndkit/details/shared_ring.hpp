@@ -0,0 +1,169 @@
+// Copyright (c) 2025 Bevan Collins
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <span>
+
+namespace wndkit::details {
+
+/*
+   A single-producer, single-consumer byte ring laid out in a shared memory block.
+
+   The producer reserves a contiguous region, fills it in place and commits it, which yields
+   a descriptor that is small enough to pass through a window message. The consumer resolves
+   the descriptor to a view of the ring and releases it once done. Records are released in
+   the order they were committed.
+
+   Positions are 64-bit and only ever increase, so a position maps to an offset with
+   `position % capacity`. A record never wraps: if it does not fit before the end of the
+   ring the remaining tail is skipped.
+
+   Descriptors arriving from another process are validated before use.
+
+   This header has no Win32 dependencies; the memory block can come from a Win32 file
+   mapping or a POSIX shared memory object.
+*/
+class shared_ring {
+public:
+  static constexpr uint32_t magic = 0x676e6972; // 'ring'
+  static constexpr size_t record_alignment = 16;
+
+  struct descriptor {
+    uint64_t offset; // position of the first byte
+    uint64_t size;   // number of bytes written
+    uint64_t end;    // position following the record
+  };
+
+  struct reservation {
+    std::span<std::byte> bytes;
+    descriptor desc;
+  };
+
+  // the size of the shared memory block needed for a ring of `capacity` bytes
+  static constexpr size_t required_size(size_t capacity) {
+    return sizeof(header) + capacity;
+  }
+
+  // initialises a new ring in `memory`
+  static shared_ring create(std::span<std::byte> memory) {
+    auto capacity = (memory.size() - sizeof(header)) / record_alignment * record_alignment;
+    auto hdr = new (memory.data()) header;
+    hdr->capacity = capacity;
+    hdr->write_pos.store(0, std::memory_order_relaxed);
+    hdr->read_pos.store(0, std::memory_order_relaxed);
+    hdr->magic.store(magic, std::memory_order_release);
+
+    return shared_ring(hdr, memory.data() + sizeof(header));
+  }
+
+  // attaches to a ring created by another process; returns nullopt if `memory` does not hold one
+  static std::optional<shared_ring> attach(std::span<std::byte> memory) {
+    if (memory.size() < sizeof(header))
+      return std::nullopt;
+
+    auto hdr = reinterpret_cast<header*>(memory.data());
+    if (hdr->magic.load(std::memory_order_acquire) != magic)
+      return std::nullopt;
+    if (hdr->capacity == 0 || hdr->capacity % record_alignment != 0 || hdr->capacity > memory.size() - sizeof(header))
+      return std::nullopt;
+
+    return shared_ring(hdr, memory.data() + sizeof(header));
+  }
+
+  size_t capacity() const {
+    return static_cast<size_t>(header_->capacity);
+  }
+
+  // producer: reserves `size` contiguous bytes, or returns nullopt if the ring is too full
+  std::optional<reservation> reserve(size_t size) const {
+    auto capacity = header_->capacity;
+    auto aligned = align_up(size);
+    if (aligned > capacity)
+      return std::nullopt;
+
+    auto write = header_->write_pos.load(std::memory_order_relaxed);
+    auto read = header_->read_pos.load(std::memory_order_acquire);
+
+    auto start = write;
+    auto index = write % capacity;
+    if (index + aligned > capacity)
+      start += capacity - index; // skip the tail
+
+    if (start + aligned - read > capacity)
+      return std::nullopt;
+
+    return reservation{
+      {data_ + start % capacity, size},
+      {start, size, start + aligned}
+    };
+  }
+
+  // producer: publishes a filled reservation to the consumer
+  descriptor commit(const reservation& r) const {
+    header_->write_pos.store(r.desc.end, std::memory_order_release);
+    return r.desc;
+  }
+
+  // producer: copies `bytes` into the ring
+  std::optional<descriptor> write(std::span<const std::byte> bytes) const {
+    auto r = reserve(bytes.size());
+    if (!r)
+      return std::nullopt;
+
+    std::copy(bytes.begin(), bytes.end(), r->bytes.begin());
+    return commit(*r);
+  }
+
+  // consumer: resolves a descriptor to the committed bytes, or nullopt if it is not valid
+  std::optional<std::span<const std::byte>> read(const descriptor& d) const {
+    auto capacity = header_->capacity;
+    auto read = header_->read_pos.load(std::memory_order_relaxed);
+    auto write = header_->write_pos.load(std::memory_order_acquire);
+
+    if (d.offset < read || d.end > write || d.offset > d.end || d.size > d.end - d.offset)
+      return std::nullopt;
+    if (d.offset % capacity + d.size > capacity)
+      return std::nullopt;
+
+    return std::span<const std::byte>{data_ + d.offset % capacity, static_cast<size_t>(d.size)};
+  }
+
+  // consumer: returns the space used by `d` (and any record before it) to the producer
+  void release(const descriptor& d) const {
+    header_->read_pos.store(d.end, std::memory_order_release);
+  }
+
+private:
+  struct header {
+    std::atomic<uint32_t> magic;
+    uint64_t capacity;
+    alignas(64) std::atomic<uint64_t> write_pos;
+    alignas(64) std::atomic<uint64_t> read_pos;
+  };
+
+  // the positions are shared between processes so must not rely on a lock
+  static_assert(std::atomic<uint64_t>::is_always_lock_free);
+  static_assert(std::atomic<uint32_t>::is_always_lock_free);
+  static_assert(sizeof(header) % record_alignment == 0);
+
+  shared_ring(header* hdr, std::byte* data) :
+    header_(hdr),
+    data_(data) {
+  }
+
+  static constexpr uint64_t align_up(uint64_t size) {
+    return (size + record_alignment - 1) / record_alignment * record_alignment;
+  }
+
+  header* header_;
+  std::byte* data_;
+};
+
+}
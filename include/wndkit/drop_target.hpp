@@ -0,0 +1,271 @@
+// Copyright (c) 2025 Bevan Collins
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <windows.h>
+#include <shellapi.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "custom_message.hpp"
+#include "message_handler.hpp"
+
+namespace wndkit {
+
+struct dropped_file {
+  std::filesystem::path path;
+  uintmax_t size{};
+  std::filesystem::file_time_type last_write_time{};
+  bool is_directory{};
+};
+
+struct drop_batch {
+  uint64_t drop_id{};
+  std::vector<dropped_file> files;
+  bool last{}; // no more batches will follow for this drop
+};
+
+/*
+   Processes WM_DROPFILES off the UI thread.
+
+   The dropped file list is copied out of the HDROP once and the HDROP is released
+   immediately. Dropped directories are expanded and every file is stat'ed on worker
+   threads owned by the target (started by the first drop and kept for later ones), which
+   post the results back to the window in batches as a `drop_target::batch_message`. The
+   final batch of a drop has `last` set.
+
+   Work still in progress is cancelled by calling `cancel`. When the window is destroyed,
+   or the target is, the work is cancelled and the worker threads are joined.
+
+   The window must accept files (WS_EX_ACCEPTFILES or DragAcceptFiles).
+
+   Example:
+     drop_target_.attach(message_handler_, [this](HWND, const wndkit::drop_batch& batch) {
+       model_.append(batch.files);
+       if (batch.last)
+         status_.set_text(L"Ready");
+     });
+*/
+class drop_target {
+public:
+  struct options {
+    unsigned worker_count{4};
+    size_t batch_size{256};
+    bool expand_directories{true};
+  };
+
+  using batch_message = custom_message<drop_batch, drop_target>;
+
+  drop_target() :
+    drop_target(options{}) {
+  }
+
+  explicit drop_target(options opts) :
+    options_(opts) {
+  }
+
+  drop_target(const drop_target&) = delete;
+  drop_target& operator=(const drop_target&) = delete;
+
+  ~drop_target() {
+    stop_workers();
+  }
+
+  /*
+     The handler must be invocable as: handler(HWND, const drop_batch&)
+  */
+  template<typename Handler>
+  requires std::invocable<Handler, HWND, const drop_batch&>
+  void attach(message_handler& handler, Handler&& on_batch) {
+    handler.on_message<WM_DROPFILES>([this](HWND hwnd, const dropfiles_params& params) {
+      start(hwnd, params.hdrop());
+    });
+
+    handler.on_message<WM_NCDESTROY>([this](HWND, const message_params&) -> std::optional<LRESULT> {
+      stop_workers();
+      return std::nullopt; // leave WM_NCDESTROY to any other handlers
+    });
+
+    handler.on_custom_message<batch_message>([on_batch = std::forward<Handler>(on_batch)](HWND hwnd, drop_batch& batch) mutable {
+      on_batch(hwnd, batch);
+    });
+  }
+
+  // cancels every drop that is still being processed
+  void cancel() {
+    std::lock_guard lock(mutex_);
+    stop_.request_stop();
+    stop_ = std::stop_source{};
+    queue_.clear();
+  }
+
+private:
+  struct drop_job {
+    HWND hwnd;
+    uint64_t id;
+    std::stop_token stop;
+
+    // held while posting, so the batches of a drop are posted in order and `last` comes after the others
+    std::mutex mutex;
+    std::vector<dropped_file> files; // found but not posted yet
+    size_t pending{};                // paths queued or being processed
+    bool posted{true};               // false once a post failed (the window is gone)
+  };
+
+  // a path to process, for a drop
+  struct work_item {
+    std::shared_ptr<drop_job> job;
+    std::filesystem::path path;
+  };
+
+  void start(HWND hwnd, HDROP hdrop) {
+    std::vector<std::filesystem::path> paths;
+    auto count = DragQueryFileW(hdrop, 0xFFFFFFFF, nullptr, 0);
+    std::wstring name;
+    for (UINT i = 0; i < count; ++i) {
+      name.resize(DragQueryFileW(hdrop, i, nullptr, 0));
+      DragQueryFileW(hdrop, i, name.data(), static_cast<UINT>(name.size() + 1));
+      paths.emplace_back(name);
+    }
+    DragFinish(hdrop);
+
+    if (paths.empty()) {
+      batch_message::post(hwnd, ++drop_id_, std::vector<dropped_file>{}, true);
+      return;
+    }
+
+    {
+      std::lock_guard lock(mutex_);
+      auto job = std::make_shared<drop_job>(hwnd, ++drop_id_, stop_.get_token());
+      job->pending = paths.size();
+      for (auto& path : paths)
+        queue_.push_back({job, std::move(path)});
+    }
+    work_available_.notify_all();
+
+    // the workers are kept for later drops
+    if (workers_.empty()) {
+      auto workers = std::max(options_.worker_count, 1u);
+      for (unsigned i = 0; i < workers; ++i)
+        workers_.emplace_back([this](std::stop_token stop) { worker(stop); });
+    }
+  }
+
+  // cancels the drops in progress and joins the worker threads; a later drop starts them again
+  void stop_workers() {
+    cancel();
+    workers_.clear(); // each jthread asks its worker to stop, then joins it
+  }
+
+  void worker(std::stop_token stop) {
+    while (true) {
+      work_item item;
+      {
+        std::unique_lock lock(mutex_);
+        if (!work_available_.wait(lock, stop, [this] { return !queue_.empty(); }))
+          return;
+
+        item = std::move(queue_.front());
+        queue_.pop_front();
+      }
+
+      auto& job = *item.job;
+      std::vector<dropped_file> files;
+      std::vector<std::filesystem::path> subdirectories;
+      process(job, item.path, files, subdirectories);
+
+      // the subdirectories are counted before this path is finished, so the drop cannot complete early
+      if (!subdirectories.empty()) {
+        {
+          std::lock_guard lock(job.mutex);
+          job.pending += subdirectories.size();
+        }
+        {
+          std::lock_guard lock(mutex_);
+          if (job.stop.stop_requested())
+            continue;
+
+          for (auto& path : subdirectories)
+            queue_.push_back({item.job, std::move(path)});
+        }
+        work_available_.notify_all();
+      }
+
+      finish(job, files);
+    }
+  }
+
+  // adds the files found for a path to its drop, posting a batch when there are enough or the drop is complete
+  void finish(drop_job& job, std::vector<dropped_file>& files) {
+    std::lock_guard lock(job.mutex);
+    auto complete = --job.pending == 0;
+    if (job.stop.stop_requested() || !job.posted)
+      return;
+
+    std::move(files.begin(), files.end(), std::back_inserter(job.files));
+    if (!job.files.empty() && (complete || job.files.size() >= options_.batch_size))
+      job.posted = batch_message::post(job.hwnd, job.id, std::exchange(job.files, {}), false);
+
+    if (complete && job.posted)
+      batch_message::post(job.hwnd, job.id, std::vector<dropped_file>{}, true);
+  }
+
+  void process(const drop_job& job, const std::filesystem::path& path, std::vector<dropped_file>& files, std::vector<std::filesystem::path>& subdirectories) const {
+    std::error_code ec;
+    auto status = std::filesystem::symlink_status(path, ec);
+    if (ec)
+      return;
+
+    if (!std::filesystem::is_directory(status)) {
+      dropped_file file{path};
+      file.size = std::filesystem::file_size(path, ec);
+      file.last_write_time = std::filesystem::last_write_time(path, ec);
+      files.push_back(std::move(file));
+      return;
+    }
+
+    files.push_back({path, 0, std::filesystem::last_write_time(path, ec), true});
+    if (!options_.expand_directories)
+      return;
+
+    // directory entries carry the attributes from the enumeration, so this does not stat each file again
+    auto options = std::filesystem::directory_options::skip_permission_denied;
+    for (std::filesystem::directory_iterator it(path, options, ec), end; !ec && it != end; it.increment(ec)) {
+      if (job.stop.stop_requested())
+        return;
+
+      // errors for a single entry must not end the enumeration
+      std::error_code entry_ec;
+      const auto& entry = *it;
+      if (entry.is_directory(entry_ec) && !entry.is_symlink(entry_ec)) {
+        subdirectories.push_back(entry.path());
+      } else {
+        dropped_file file{entry.path()};
+        file.size = entry.file_size(entry_ec);
+        file.last_write_time = entry.last_write_time(entry_ec);
+        files.push_back(std::move(file));
+      }
+    }
+  }
+
+  options options_;
+  uint64_t drop_id_{};
+
+  std::mutex mutex_;
+  std::condition_variable_any work_available_;
+  std::deque<work_item> queue_; // the paths waiting for a worker, of every drop
+  std::stop_source stop_;       // stopped by `cancel`, for the drops started before it
+  std::vector<std::jthread> workers_;
+};
+
+}
@@ -0,0 +1,285 @@
+// Copyright (c) 2025 Bevan Collins
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <windows.h>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+#include "message_handler.hpp"
+#include "details/shared_ring.hpp"
+
+namespace wndkit {
+
+namespace details {
+
+// sent as the WM_COPYDATA buffer when the payload is in the shared ring
+struct ipc_descriptor {
+  uint32_t magic;
+  uint32_t reserved;
+  shared_ring::descriptor ring;
+};
+
+inline constexpr uint32_t ipc_descriptor_magic = 0x63706977; // 'wipc'
+
+// set in COPYDATASTRUCT::dwData when the buffer is an ipc_descriptor
+inline constexpr ULONG_PTR ipc_descriptor_flag = ULONG_PTR{1} << (sizeof(ULONG_PTR) * 8 - 1);
+
+inline std::wstring ipc_mapping_name(const std::wstring& name) {
+  return L"Local\\wndkit.ipc." + name;
+}
+
+// a mapped view of a named file mapping
+class ipc_mapping {
+public:
+  ipc_mapping() = default;
+
+  ipc_mapping(HANDLE mapping, size_t size) :
+    mapping_(mapping) {
+    view_ = MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!view_) {
+      auto error = GetLastError();
+      CloseHandle(mapping_);
+      throw std::system_error(static_cast<int>(error), std::system_category());
+    }
+
+    if (!size) {
+      MEMORY_BASIC_INFORMATION info{};
+      VirtualQuery(view_, &info, sizeof(info));
+      size = info.RegionSize;
+    }
+    size_ = size;
+  }
+
+  ipc_mapping(const ipc_mapping&) = delete;
+  ipc_mapping& operator=(const ipc_mapping&) = delete;
+
+  ~ipc_mapping() {
+    if (view_)
+      UnmapViewOfFile(view_);
+    if (mapping_)
+      CloseHandle(mapping_);
+  }
+
+  std::span<std::byte> bytes() const {
+    return {static_cast<std::byte*>(view_), size_};
+  }
+
+private:
+  HANDLE mapping_{};
+  void* view_{};
+  size_t size_{};
+};
+
+}
+
+/*
+   A message received over an ipc channel.
+
+   `bytes` is a view of either the WM_COPYDATA buffer or the shared ring, and is only valid
+   until the handler returns.
+*/
+struct ipc_message {
+  HWND sender;
+  ULONG_PTR type;
+  std::span<const std::byte> bytes;
+
+  // reinterprets the bytes as an array of trivially copyable `T`
+  template<typename T>
+  requires std::is_trivially_copyable_v<T>
+  std::span<const T> view() const {
+    if (bytes.size() % sizeof(T) != 0 || reinterpret_cast<uintptr_t>(bytes.data()) % alignof(T) != 0)
+      throw std::invalid_argument("ipc_message does not hold an array of the requested type");
+
+    return {reinterpret_cast<const T*>(bytes.data()), bytes.size() / sizeof(T)};
+  }
+};
+
+/*
+   The sending end of an ipc channel.
+
+   Payloads up to `inline_limit` bytes are sent directly with WM_COPYDATA. Larger payloads are
+   written to a shared memory ring created by the sender, and only a descriptor is sent.
+   The receiver reads the payload in place, so it is copied once (into the ring) instead of
+   through the kernel and into the receiver's address space.
+
+   A sender is used from a single thread. Each channel name has one sender and one receiver.
+
+   Example:
+     wndkit::ipc_sender channel(L"results");
+     channel.send(receiver_hwnd, hwnd, RESULT_ROWS, std::span<const row>(rows));
+*/
+class ipc_sender {
+public:
+  static constexpr size_t default_ring_capacity = 16 * 1024 * 1024;
+  static constexpr size_t default_inline_limit  = 64 * 1024;
+
+  explicit ipc_sender(const std::wstring& name, size_t ring_capacity = default_ring_capacity, size_t inline_limit = default_inline_limit) :
+    inline_limit_(inline_limit),
+    mapping_(create_mapping(name, details::shared_ring::required_size(ring_capacity)), details::shared_ring::required_size(ring_capacity)),
+    ring_(details::shared_ring::create(mapping_.bytes())) {
+  }
+
+  // sends `bytes` and returns the receiver's WM_COPYDATA result
+  LRESULT send(HWND target, HWND from, ULONG_PTR type, std::span<const std::byte> bytes) {
+    assert((type & details::ipc_descriptor_flag) == 0);
+
+    if (bytes.size() > inline_limit_) {
+      if (auto desc = ring_.write(bytes))
+        return send_descriptor(target, from, type, *desc);
+    }
+
+    return send_inline(target, from, type, bytes);
+  }
+
+  template<typename T>
+  requires std::is_trivially_copyable_v<T>
+  LRESULT send(HWND target, HWND from, ULONG_PTR type, std::span<const T> items) {
+    return send(target, from, type, std::as_bytes(items));
+  }
+
+  /*
+     Sends a payload of `size` bytes that `writer` serializes in place, avoiding an
+     intermediate buffer for large payloads.
+
+     The writer must be invocable as: writer(std::span<std::byte>)
+  */
+  template<typename Writer>
+  requires std::invocable<Writer, std::span<std::byte>>
+  LRESULT send_with(HWND target, HWND from, ULONG_PTR type, size_t size, Writer&& writer) {
+    assert((type & details::ipc_descriptor_flag) == 0);
+
+    if (size > inline_limit_) {
+      if (auto reservation = ring_.reserve(size)) {
+        writer(reservation->bytes);
+        return send_descriptor(target, from, type, ring_.commit(*reservation));
+      }
+    }
+
+    std::vector<std::byte> buffer(size);
+    writer(std::span<std::byte>(buffer));
+    return send_inline(target, from, type, buffer);
+  }
+
+private:
+  static HANDLE create_mapping(const std::wstring& name, size_t size) {
+    auto mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(static_cast<uint64_t>(size) >> 32), static_cast<DWORD>(size),
+        details::ipc_mapping_name(name).c_str());
+    if (!mapping)
+      throw std::system_error(static_cast<int>(GetLastError()), std::system_category());
+
+    return mapping;
+  }
+
+  static LRESULT send_inline(HWND target, HWND from, ULONG_PTR type, std::span<const std::byte> bytes) {
+    if (bytes.size() > MAXDWORD)
+      throw std::length_error("ipc payload is too large for WM_COPYDATA");
+
+    COPYDATASTRUCT cds{type, static_cast<DWORD>(bytes.size()), const_cast<std::byte*>(bytes.data())};
+    return SendMessageW(target, WM_COPYDATA, reinterpret_cast<WPARAM>(from), reinterpret_cast<LPARAM>(&cds));
+  }
+
+  LRESULT send_descriptor(HWND target, HWND from, ULONG_PTR type, const details::shared_ring::descriptor& desc) {
+    details::ipc_descriptor descriptor{details::ipc_descriptor_magic, 0, desc};
+    COPYDATASTRUCT cds{type | details::ipc_descriptor_flag, sizeof(descriptor), &descriptor};
+    auto result = SendMessageW(target, WM_COPYDATA, reinterpret_cast<WPARAM>(from), reinterpret_cast<LPARAM>(&cds));
+
+    // WM_COPYDATA is synchronous, so a receiver that did not take the record never will
+    if (!result)
+      ring_.release(desc);
+
+    return result;
+  }
+
+  size_t inline_limit_;
+  details::ipc_mapping mapping_;
+  details::shared_ring ring_;
+};
+
+/*
+   The receiving end of an ipc channel.
+
+   `attach` registers a WM_COPYDATA handler that presents both inline and shared-ring
+   payloads as an `ipc_message`. The shared ring is opened when the first large payload
+   arrives.
+
+   Example:
+     wndkit::ipc_receiver channel(L"results");
+     channel.attach(message_handler_, [this](HWND, const wndkit::ipc_message& msg) {
+       if (msg.type == RESULT_ROWS)
+         show_rows(msg.view<row>());
+     });
+*/
+class ipc_receiver {
+public:
+  explicit ipc_receiver(std::wstring name) :
+    name_(std::move(name)) {
+  }
+
+  /*
+     The handler must be invocable as: handler(HWND, const ipc_message&)
+  */
+  template<typename Handler>
+  requires std::invocable<Handler, HWND, const ipc_message&>
+  void attach(message_handler& handler, Handler&& on_message) {
+    handler.on_message<WM_COPYDATA>([this, on_message = std::forward<Handler>(on_message)](HWND hwnd, copydata_params& params) mutable -> std::optional<LRESULT> {
+        const auto& cds = params.copydatastruct();
+        auto sender = reinterpret_cast<HWND>(params.wparam);
+
+        if ((cds.dwData & details::ipc_descriptor_flag) == 0) {
+          on_message(hwnd, ipc_message{sender, cds.dwData, {static_cast<const std::byte*>(cds.lpData), cds.cbData}});
+          return TRUE;
+        }
+
+        if (cds.cbData != sizeof(details::ipc_descriptor))
+          return std::nullopt;
+
+        auto descriptor = *static_cast<const details::ipc_descriptor*>(cds.lpData);
+        if (descriptor.magic != details::ipc_descriptor_magic || !open_ring())
+          return std::nullopt;
+
+        auto bytes = ring_->read(descriptor.ring);
+        if (!bytes)
+          return std::nullopt;
+
+        // release the record even if the handler throws
+        struct release_on_exit {
+          const details::shared_ring& ring;
+          const details::shared_ring::descriptor& desc;
+          ~release_on_exit() { ring.release(desc); }
+        } release{*ring_, descriptor.ring};
+
+        on_message(hwnd, ipc_message{sender, cds.dwData & ~details::ipc_descriptor_flag, *bytes});
+        return TRUE;
+      });
+  }
+
+private:
+  bool open_ring() {
+    if (ring_)
+      return true;
+
+    auto mapping = OpenFileMappingW(FILE_MAP_ALL_ACCESS, FALSE, details::ipc_mapping_name(name_).c_str());
+    if (!mapping)
+      return false;
+
+    mapping_.emplace(mapping, 0);
+    ring_ = details::shared_ring::attach(mapping_->bytes());
+    return ring_.has_value();
+  }
+
+  std::wstring name_;
+  std::optional<details::ipc_mapping> mapping_;
+  std::optional<details::shared_ring> ring_;
+};
+
+}
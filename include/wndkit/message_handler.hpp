@@ -1,378 +1,626 @@
-// Copyright (c) 2025 Bevan Collins
-// Licensed under the MIT License. See LICENSE file in the project root for full license information.
-
-#pragma once
-
-#include <windows.h>
-#include <concepts>
-#include <functional>
-#include <unordered_map>
-#include <optional>
-#include <vector>
-#include "message_filters.hpp"
-#include "details/message_traits.hpp"
-#include "details/notify_traits.hpp"
-
-namespace wndkit {
-
-class message_handler {
-public:
-  /*
-     Registers a message handler for a specific Windows message.
-
-     This is the primary interface for binding custom message handlers to
-     Windows messages. It allows filtering based on message parameters and
-     supports automatic type conversion to the appropriate parameter type
-     for the message.
-
-     Template Parameters:
-       Msg    - The Windows message ID (e.g., WM_PAINT, WM_COMMAND).
-       Handler - The handler to invoke when the message is received.
-       Filter  - (Optional) A filter object to control handler invocation
-                 based on message-specific criteria (defaults to `no_filter`).
-
-     Requirements:
-       - The `Handler` must accept parameters compatible with the message ID.
-       - The parameter type for the message must be compatible with `message_params`.
-
-     Returns:
-       A reference to the `message_handler` to support method chaining.
-
-     Example:
-       handler.on_message<WM_PAINT>([](HWND hwnd, paint_params& params) {
-         // handle WM_PAINT
-       });
-  */
-  template<UINT Msg, typename Handler, typename Filter = no_filter>
-  requires details::message_params_compatible<typename details::message_traits<Msg>::param_type>
-  message_handler& on_message(Handler&& handler, Filter filter = {}) {
-    using param_type = typename details::message_traits<Msg>::param_type;
-    using handler_result_type = std::invoke_result_t<Handler, HWND, param_type&>;
-
-    handlers_[Msg].push_back([handler = std::forward<Handler>(handler), filter = std::move(filter)](HWND hwnd, message_params& params) mutable -> std::optional<LRESULT> {
-        auto& specialised_params = static_cast<param_type&>(params);
-
-        if (!filter.matches(specialised_params))
-          return std::nullopt;
-
-        // invoke the handler
-        if constexpr (std::is_same_v<handler_result_type, void>) {
-          handler(hwnd, specialised_params);
-          return 0; // auto-return 0 if handler returns void
-        } else {
-          return handler(hwnd, specialised_params);
-        }
-      });
-
-    return *this;
-  }
-
-  /*
-     Registers a message handler that invokes a handler without passing any message parameters.
-     This is typically used when the handler is a signal, lambda, or function object
-     that takes no arguments.
-
-     An optional filter can be provided to control whether the handler should be invoked
-     for a given message instance.
-
-     Examples:
-       on_message_invoke<WM_COMMAND>(some_signal);
-       on_message_invoke<WM_TIMER>([] { update_timer(); });
-
-     The handler must be invocable as: handler()
-  */
-  template<UINT Msg, typename Handler, typename Filter = no_filter>
-  requires std::invocable<Handler>
-  message_handler& on_message_invoke(Handler&& handler, Filter filter = {}) {
-    return on_message<Msg>([handler = std::forward<Handler>(handler)](HWND, auto&) mutable {
-        std::invoke(handler);
-      }, std::move(filter));
-  }
-
-  /*
-     Registers a message handler that invokes a handler with HWND as the first argument,
-     followed by any additional user-supplied arguments.
-  
-     This overload allows you to bind any handler that takes an HWND and fixed arguments,
-     and register it as the handler for a specific Windows message.
-  
-     Examples:
-       on_message_invoke<WM_CLOSE>(DestroyWindow);
-       on_message_invoke<WM_RBUTTONDOWN>(MessageBoxW, L"Right click!", L"Info", MB_OK);
-
-     The handler must be invocable as: handler(HWND, Args...)
-  */
-  template<UINT Msg, typename Handler, typename... Args>
-  requires std::invocable<Handler, HWND, Args...>
-  message_handler& on_message_invoke(Handler&& handler, Args&&... args) {
-    return on_message<Msg>(
-        [handler = std::forward<Handler>(handler),
-        ...captured_args = std::forward<Args>(args)](HWND hwnd, auto&) mutable {
-      std::invoke(handler, hwnd, captured_args...);
-    });
-  }
-
-  /*
-     Registers a message handler that invokes a handler without passing HWND,
-     but instead binds a fixed set of arguments to be passed to the handler.
-
-     This overload is useful when the message handler does not need the HWND,
-     and the handler is already fully bound with the necessary arguments.
-
-     Examples:
-       on_message_invoke<WM_DESTROY>(PostQuitMessage, 0);
-       on_message_invoke<WM_USER>(some_function, 42, "data");
-
-     The handler must be invocable as: handler(Args...)
-  */
-  template<UINT Msg, typename Handler, typename... Args>
-  requires (sizeof...(Args) > 0) && std::invocable<Handler, Args...>
-  message_handler& on_message_invoke(Handler&& handler, Args&&... args) {
-    return on_message<Msg>(
-        [handler = std::forward<Handler>(handler),
-        ...captured_args = std::forward<Args>(args)](HWND, auto&) mutable {
-      std::invoke(handler, captured_args...);
-    });
-  }
-
-  /*
-     Registers a handler for a specific notification message (WM_NOTIFY) that filters on a given
-     notification code (Code) and control ID (control_id).
-
-     The handler will be invoked with the HWND and a specialized parameter derived from the
-     notification message. The parameter type is determined by the notification code using the
-     `details::notify_traits` template.
-
-     The handler must accept the HWND and a specialized notification parameter as arguments.
-
-     Examples:
-       on_notify<TVN_SELCHANGED>(IDC_METHODS, [](HWND hwnd, NMTREEVIEWW* params) {
-         // Handle tree-view selection change.
-       });
-       on_notify<DL_DROPPED>(IDC_LIST, [](HWND hwnd, DRAGLISTINFO* params) {
-         // Handle button click event.
-       });
-
-     If the handler's return type is `void`, the function automatically returns 0.
-     Otherwise, it returns the result of the handler invocation.
-  */
-  template<UINT Code, typename Handler>
-  message_handler& on_notify(UINT_PTR control_id, Handler&& handler) {
-    return on_message<WM_NOTIFY>([handler = std::forward<Handler>(handler)](HWND hwnd, notify_params& params) mutable {
-      using param_type = typename details::notify_traits<Code>::param_type;
-      using handler_result_type = std::invoke_result_t<Handler, HWND, param_type&>;
-
-      auto specialised_params = reinterpret_cast<param_type*>(params.nmhdr());
-
-      if constexpr (std::is_same_v<handler_result_type, void>) {
-        handler(hwnd, *specialised_params);
-        return 0; // auto-return 0 if handler returns void
-      } else {
-        return handler(hwnd, *specialised_params);
-      }
-    }, notify_filter{.code = Code, .id_from = control_id});
-  }
-
-  /*
-     Registers a handler for a specific WM_NOTIFY notification code and control ID,
-     where the supplied handler does not require any parameters.
-
-     This is a convenience overload of `on_notify` for cases where you only want
-     to invoke a function or lambda without using the HWND or notification parameters.
-
-     The handler must be invocable without arguments: `handler()`.
-
-     Examples:
-       on_notify_invoke<TVN_SELCHANGED>(IDC_TREE, [] {
-         // Handle selection change with no parameters
-       });
-
-       on_notify_invoke<LVN_ITEMCHANGED>(IDC_LIST, SomeStaticFunction);
-
-     Internally, this wraps the handler in a lambda that discards the HWND and
-     notification parameters, and simply invokes the supplied handler.
-  */
-  template<UINT Code, typename Handler>
-  requires std::invocable<Handler>
-  message_handler& on_notify_invoke(UINT_PTR control_id, Handler&& handler) {
-    return on_notify<Code>(control_id, [handler = std::forward<Handler>(handler)](HWND, auto&) mutable {
-        std::invoke(handler);
-      });
-  }
-
-  /*
-     Registers a handler for a specific command control ID, typically triggered by menu items,
-     buttons, or other controls sending WM_COMMAND messages.
-
-     Internally, this uses a filter to match only WM_COMMAND messages with the given control ID.
-
-     Example:
-       on_command(IDOK, [](HWND hwnd, auto&) {
-         EndDialog(hwnd, IDOK);
-       });
-
-     The handler must be invocable as: handler(HWND, command_message_params&)
-  */
-  template<typename Handler>
-  message_handler& on_command(WORD id, Handler&& handler) {
-    return on_message<WM_COMMAND>(handler, command_filter{.id = id});
-  }
-
-  /*
-     Registers a handler for a specific WM_COMMAND control ID and invokes a handler
-     without any parameters when the command is received.
-
-     This overload is useful when the associated action does not need to inspect the message
-     parameters and can be triggered directly.
-
-     Example:
-       on_command_invoke(IDOK, [] {
-         SaveAndExit(TRUE);
-       });
-
-     The handler must be invocable as: handler()
-  */
-  template<typename Handler>
-  requires std::invocable<Handler>
-  message_handler& on_command_invoke(WORD id, Handler&& handler) {
-    return on_command(id, [handler = std::forward<Handler>(handler)](HWND, auto&) mutable {
-        std::invoke(handler);
-      });
-  }
-
-  /*
-     Registers a WM_COMMAND handler for a specific control ID, invoking the provided handler
-     with HWND as the first argument, followed by any additional user-supplied arguments.
-
-     This overload is ideal for handler that require a window handle along with fixed arguments,
-     such as standard Windows API functions.
-
-     Examples:
-       on_command_invoke(IDOK, EndDialog, IDOK);
-       on_command_invoke(IDC_SHOW_INFO, MessageBoxW, L"Title", L"Info", MB_OK);
-
-     The handler must be invocable as: handler(HWND, Args...)
-  */
-  template<typename Handler, typename... Args>
-  requires std::invocable<Handler, HWND, Args...>
-  message_handler& on_command_invoke(WORD id, Handler&& handler, Args&&... args) {
-    return on_command(id,
-        [handler = std::forward<Handler>(handler),
-        ...captured_args = std::forward<Args>(args)](HWND hwnd, auto&) mutable {
-      std::invoke(handler, hwnd, captured_args...);
-    });
-  }
-
-  /*
-     Registers a WM_COMMAND handler for a specific control ID, invoking the provided handler
-     with fixed arguments (excluding HWND). This is useful when the handler does not require
-     a window handle and only needs fixed arguments.
-
-     This is typically used for functions or functors that operate independently of HWND.
-
-     Examples:
-       on_command_invoke(IDOK, PostQuitMessage, 0);
-       on_command_invoke(IDC_LOG, some_logger_function, "Button clicked");
-
-     The handler must be invocable as: handler(Args...)
-     At least one argument must be provided.
-  */
-  template<typename Handler, typename... Args>
-  requires (sizeof...(Args) > 0) && std::invocable<Handler, Args...>
-  message_handler& on_command_invoke(WORD id, Handler&& handler, Args&&... args) {
-    return on_command(id,
-        [handler = std::forward<Handler>(handler),
-        ...captured_args = std::forward<Args>(args)](HWND, auto&) mutable {
-      std::invoke(handler, captured_args...);
-    });
-  }
-
-  /*
-     Registers a handler for a specific WM_COMMAND message identified by a control ID (`id`)
-     and a notification code (`NotifCode`). The handler is invoked with the full `command_params`
-     structure, allowing access to both the `id` and the `notif_code`, as well as other metadata.
-
-     This is useful for handling control notifications like `BN_CLICKED` for buttons or
-     `EN_CHANGE` for edit controls, in a type-safe way.
-
-     The handler must be invocable as: `handler(HWND, command_params&)`.
-
-     If the handler returns `void`, this wrapper will automatically return 0 to Windows.
-
-     Examples:
-       on_command_notify<BN_CLICKED>(IDC_MY_BUTTON, [](HWND hwnd, command_params& params) {
-         MessageBox(hwnd, L"Button clicked", L"Info", MB_OK);
-       });
-
-     Internally, this function wraps the handler and uses a `command_filter` to ensure the
-     correct combination of `id` and `notif_code` are matched before invoking the callback.
-  */
-  template<WORD NotifCode, typename Handler>
-  message_handler& on_command_notify(WORD id, Handler&& handler) {
-    return on_message<WM_COMMAND>([handler = std::forward<Handler>(handler)](HWND hwnd, command_params& params) mutable {
-      using handler_result_type = std::invoke_result_t<Handler, HWND, command_params&>;
-
-      if constexpr (std::is_same_v<handler_result_type, void>) {
-        handler(hwnd, params);
-        return 0; // auto-return 0 if handler returns void
-      } else {
-        return handler(hwnd, params);
-      }
-    }, command_filter{.id = id, .notif_code = NotifCode});
-  }
-
-  /*
-     Registers a handler for a WM_COMMAND message with a specific control ID (`id`) and
-     notification code (`NotifyCode`), invoking a handler that takes no arguments.
-
-     This overload is useful when the callback does not need to access message parameters,
-     and the match is based solely on the ID and notification code.
-
-     The supplied handler must be invocable with zero arguments: `handler()`.
-
-     Example:
-       on_command_notify_invoke<BN_CLICKED>(IDC_MY_BUTTON, my_signal);
-
-     Internally, this wraps the zero-argument handler inside a lambda that discards
-     the usual `HWND` and `command_params` parameters, providing a concise way to bind
-     simple actions to control notifications.
-  */
-  template<WORD NotifyCode, typename Handler>
-  requires std::invocable<Handler>
-  message_handler& on_command_notify_invoke(WORD id, Handler&& handler) {
-    return on_command_notify<NotifyCode>(id, [handler = std::forward<Handler>(handler)](HWND, auto&) mutable {
-        std::invoke(handler);
-      });
-  }
-
-  /*
-     Dispatches a Windows message to a matching registered handler.
-
-     Parameters:
-       hwnd   - Handle to the window receiving the message.
-       msg    - The message ID (e.g., WM_PAINT, WM_COMMAND).
-       wparam - Additional message-specific information.
-       lparam - Additional message-specific information.
-
-     Returns:
-       An `std::optional<LRESULT>` containing the result of the first handler
-       that returns a value, or `std::nullopt` if no handler returns a value.
-  */
-  std::optional<LRESULT> call_handler(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam) const {
-    auto it = handlers_.find(msg);
-    if (it != handlers_.end()) {
-      message_params params{wparam, lparam};
-      for (const auto& callback : it->second)
-        if (auto result = callback(hwnd, params))
-          return result;
-    }
-
-    return std::nullopt;
-  }
-
-private:
-  using handler_fn = std::function<std::optional<LRESULT>(HWND, message_params&)>;
-  std::unordered_map<UINT, std::vector<handler_fn>> handlers_;
-};
-
-}
+// Copyright (c) 2025 Bevan Collins
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <windows.h>
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <optional>
+#include <system_error>
+#include <vector>
+#include "message_filters.hpp"
+#include "details/message_traits.hpp"
+#include "details/notify_traits.hpp"
+
+namespace wndkit {
+
+class message_handler {
+public:
+  /*
+     Registers a message handler for a specific Windows message.
+
+     This is the primary interface for binding custom message handlers to
+     Windows messages. It allows filtering based on message parameters and
+     supports automatic type conversion to the appropriate parameter type
+     for the message.
+
+     Template Parameters:
+       Msg    - The Windows message ID (e.g., WM_PAINT, WM_COMMAND).
+       Handler - The handler to invoke when the message is received.
+       Filter  - (Optional) A filter object to control handler invocation
+                 based on message-specific criteria (defaults to `no_filter`).
+
+     Requirements:
+       - The `Handler` must accept parameters compatible with the message ID.
+       - The parameter type for the message must be compatible with `message_params`.
+
+     Returns:
+       A reference to the `message_handler` to support method chaining.
+
+     Example:
+       handler.on_message<WM_PAINT>([](HWND hwnd, paint_params& params) {
+         // handle WM_PAINT
+       });
+  */
+  template<UINT Msg, typename Handler, typename Filter = no_filter>
+  requires details::message_params_compatible<typename details::message_traits<Msg>::param_type>
+  message_handler& on_message(Handler&& handler, Filter filter = {}) {
+    using param_type = typename details::message_traits<Msg>::param_type;
+    using handler_result_type = std::invoke_result_t<Handler, HWND, param_type&>;
+
+    handlers_[Msg].push_back([handler = std::forward<Handler>(handler), filter = std::move(filter)](HWND hwnd, message_params& params) mutable -> std::optional<LRESULT> {
+        auto& specialised_params = static_cast<param_type&>(params);
+
+        if (!filter.matches(specialised_params))
+          return std::nullopt;
+
+        // invoke the handler
+        if constexpr (std::is_same_v<handler_result_type, void>) {
+          handler(hwnd, specialised_params);
+          return 0; // auto-return 0 if handler returns void
+        } else {
+          return handler(hwnd, specialised_params);
+        }
+      });
+
+    return *this;
+  }
+
+  /*
+     Registers a message handler that invokes a handler without passing any message parameters.
+     This is typically used when the handler is a signal, lambda, or function object
+     that takes no arguments.
+
+     An optional filter can be provided to control whether the handler should be invoked
+     for a given message instance.
+
+     Examples:
+       on_message_invoke<WM_COMMAND>(some_signal);
+       on_message_invoke<WM_TIMER>([] { update_timer(); });
+
+     The handler must be invocable as: handler()
+  */
+  template<UINT Msg, typename Handler, typename Filter = no_filter>
+  requires std::invocable<Handler>
+  message_handler& on_message_invoke(Handler&& handler, Filter filter = {}) {
+    return on_message<Msg>([handler = std::forward<Handler>(handler)](HWND, auto&) mutable {
+        std::invoke(handler);
+      }, std::move(filter));
+  }
+
+  /*
+     Registers a message handler that invokes a handler with HWND as the first argument,
+     followed by any additional user-supplied arguments.
+  
+     This overload allows you to bind any handler that takes an HWND and fixed arguments,
+     and register it as the handler for a specific Windows message.
+  
+     Examples:
+       on_message_invoke<WM_CLOSE>(DestroyWindow);
+       on_message_invoke<WM_RBUTTONDOWN>(MessageBoxW, L"Right click!", L"Info", MB_OK);
+
+     The handler must be invocable as: handler(HWND, Args...)
+  */
+  template<UINT Msg, typename Handler, typename... Args>
+  requires std::invocable<Handler, HWND, Args...>
+  message_handler& on_message_invoke(Handler&& handler, Args&&... args) {
+    return on_message<Msg>(
+        [handler = std::forward<Handler>(handler),
+        ...captured_args = std::forward<Args>(args)](HWND hwnd, auto&) mutable {
+      std::invoke(handler, hwnd, captured_args...);
+    });
+  }
+
+  /*
+     Registers a message handler that invokes a handler without passing HWND,
+     but instead binds a fixed set of arguments to be passed to the handler.
+
+     This overload is useful when the message handler does not need the HWND,
+     and the handler is already fully bound with the necessary arguments.
+
+     Examples:
+       on_message_invoke<WM_DESTROY>(PostQuitMessage, 0);
+       on_message_invoke<WM_USER>(some_function, 42, "data");
+
+     The handler must be invocable as: handler(Args...)
+  */
+  template<UINT Msg, typename Handler, typename... Args>
+  requires (sizeof...(Args) > 0) && std::invocable<Handler, Args...>
+  message_handler& on_message_invoke(Handler&& handler, Args&&... args) {
+    return on_message<Msg>(
+        [handler = std::forward<Handler>(handler),
+        ...captured_args = std::forward<Args>(args)](HWND, auto&) mutable {
+      std::invoke(handler, captured_args...);
+    });
+  }
+
+  /*
+     Registers a handler for a specific notification message (WM_NOTIFY) that filters on a given
+     notification code (Code) and control ID (control_id).
+
+     The handler will be invoked with the HWND and a specialized parameter derived from the
+     notification message. The parameter type is determined by the notification code using the
+     `details::notify_traits` template.
+
+     The handler must accept the HWND and a specialized notification parameter as arguments.
+
+     Examples:
+       on_notify<TVN_SELCHANGED>(IDC_METHODS, [](HWND hwnd, NMTREEVIEWW* params) {
+         // Handle tree-view selection change.
+       });
+       on_notify<DL_DROPPED>(IDC_LIST, [](HWND hwnd, DRAGLISTINFO* params) {
+         // Handle button click event.
+       });
+
+     If the handler's return type is `void`, the function automatically returns 0.
+     Otherwise, it returns the result of the handler invocation.
+  */
+  template<UINT Code, typename Handler>
+  message_handler& on_notify(UINT_PTR control_id, Handler&& handler) {
+    return on_message<WM_NOTIFY>([handler = std::forward<Handler>(handler)](HWND hwnd, notify_params& params) mutable {
+      using param_type = typename details::notify_traits<Code>::param_type;
+      using handler_result_type = std::invoke_result_t<Handler, HWND, param_type&>;
+
+      auto specialised_params = reinterpret_cast<param_type*>(params.nmhdr());
+
+      if constexpr (std::is_same_v<handler_result_type, void>) {
+        handler(hwnd, *specialised_params);
+        return 0; // auto-return 0 if handler returns void
+      } else {
+        return handler(hwnd, *specialised_params);
+      }
+    }, notify_filter{.code = Code, .id_from = control_id});
+  }
+
+  /*
+     Registers a handler for a specific WM_NOTIFY notification code and control ID,
+     where the supplied handler does not require any parameters.
+
+     This is a convenience overload of `on_notify` for cases where you only want
+     to invoke a function or lambda without using the HWND or notification parameters.
+
+     The handler must be invocable without arguments: `handler()`.
+
+     Examples:
+       on_notify_invoke<TVN_SELCHANGED>(IDC_TREE, [] {
+         // Handle selection change with no parameters
+       });
+
+       on_notify_invoke<LVN_ITEMCHANGED>(IDC_LIST, SomeStaticFunction);
+
+     Internally, this wraps the handler in a lambda that discards the HWND and
+     notification parameters, and simply invokes the supplied handler.
+  */
+  template<UINT Code, typename Handler>
+  requires std::invocable<Handler>
+  message_handler& on_notify_invoke(UINT_PTR control_id, Handler&& handler) {
+    return on_notify<Code>(control_id, [handler = std::forward<Handler>(handler)](HWND, auto&) mutable {
+        std::invoke(handler);
+      });
+  }
+
+  /*
+     Registers a handler for a specific command control ID, typically triggered by menu items,
+     buttons, or other controls sending WM_COMMAND messages.
+
+     Internally, this uses a filter to match only WM_COMMAND messages with the given control ID.
+
+     Example:
+       on_command(IDOK, [](HWND hwnd, auto&) {
+         EndDialog(hwnd, IDOK);
+       });
+
+     The handler must be invocable as: handler(HWND, command_message_params&)
+  */
+  template<typename Handler>
+  message_handler& on_command(WORD id, Handler&& handler) {
+    return on_message<WM_COMMAND>(handler, command_filter{.id = id});
+  }
+
+  /*
+     Registers a handler for a specific WM_COMMAND control ID and invokes a handler
+     without any parameters when the command is received.
+
+     This overload is useful when the associated action does not need to inspect the message
+     parameters and can be triggered directly.
+
+     Example:
+       on_command_invoke(IDOK, [] {
+         SaveAndExit(TRUE);
+       });
+
+     The handler must be invocable as: handler()
+  */
+  template<typename Handler>
+  requires std::invocable<Handler>
+  message_handler& on_command_invoke(WORD id, Handler&& handler) {
+    return on_command(id, [handler = std::forward<Handler>(handler)](HWND, auto&) mutable {
+        std::invoke(handler);
+      });
+  }
+
+  /*
+     Registers a WM_COMMAND handler for a specific control ID, invoking the provided handler
+     with HWND as the first argument, followed by any additional user-supplied arguments.
+
+     This overload is ideal for handler that require a window handle along with fixed arguments,
+     such as standard Windows API functions.
+
+     Examples:
+       on_command_invoke(IDOK, EndDialog, IDOK);
+       on_command_invoke(IDC_SHOW_INFO, MessageBoxW, L"Title", L"Info", MB_OK);
+
+     The handler must be invocable as: handler(HWND, Args...)
+  */
+  template<typename Handler, typename... Args>
+  requires std::invocable<Handler, HWND, Args...>
+  message_handler& on_command_invoke(WORD id, Handler&& handler, Args&&... args) {
+    return on_command(id,
+        [handler = std::forward<Handler>(handler),
+        ...captured_args = std::forward<Args>(args)](HWND hwnd, auto&) mutable {
+      std::invoke(handler, hwnd, captured_args...);
+    });
+  }
+
+  /*
+     Registers a WM_COMMAND handler for a specific control ID, invoking the provided handler
+     with fixed arguments (excluding HWND). This is useful when the handler does not require
+     a window handle and only needs fixed arguments.
+
+     This is typically used for functions or functors that operate independently of HWND.
+
+     Examples:
+       on_command_invoke(IDOK, PostQuitMessage, 0);
+       on_command_invoke(IDC_LOG, some_logger_function, "Button clicked");
+
+     The handler must be invocable as: handler(Args...)
+     At least one argument must be provided.
+  */
+  template<typename Handler, typename... Args>
+  requires (sizeof...(Args) > 0) && std::invocable<Handler, Args...>
+  message_handler& on_command_invoke(WORD id, Handler&& handler, Args&&... args) {
+    return on_command(id,
+        [handler = std::forward<Handler>(handler),
+        ...captured_args = std::forward<Args>(args)](HWND, auto&) mutable {
+      std::invoke(handler, captured_args...);
+    });
+  }
+
+  /*
+     Registers a handler for a specific WM_COMMAND message identified by a control ID (`id`)
+     and a notification code (`NotifCode`). The handler is invoked with the full `command_params`
+     structure, allowing access to both the `id` and the `notif_code`, as well as other metadata.
+
+     This is useful for handling control notifications like `BN_CLICKED` for buttons or
+     `EN_CHANGE` for edit controls, in a type-safe way.
+
+     The handler must be invocable as: `handler(HWND, command_params&)`.
+
+     If the handler returns `void`, this wrapper will automatically return 0 to Windows.
+
+     Examples:
+       on_command_notify<BN_CLICKED>(IDC_MY_BUTTON, [](HWND hwnd, command_params& params) {
+         MessageBox(hwnd, L"Button clicked", L"Info", MB_OK);
+       });
+
+     Internally, this function wraps the handler and uses a `command_filter` to ensure the
+     correct combination of `id` and `notif_code` are matched before invoking the callback.
+  */
+  template<WORD NotifCode, typename Handler>
+  message_handler& on_command_notify(WORD id, Handler&& handler) {
+    return on_message<WM_COMMAND>([handler = std::forward<Handler>(handler)](HWND hwnd, command_params& params) mutable {
+      using handler_result_type = std::invoke_result_t<Handler, HWND, command_params&>;
+
+      if constexpr (std::is_same_v<handler_result_type, void>) {
+        handler(hwnd, params);
+        return 0; // auto-return 0 if handler returns void
+      } else {
+        return handler(hwnd, params);
+      }
+    }, command_filter{.id = id, .notif_code = NotifCode});
+  }
+
+  /*
+     Registers a handler for a WM_COMMAND message with a specific control ID (`id`) and
+     notification code (`NotifyCode`), invoking a handler that takes no arguments.
+
+     This overload is useful when the callback does not need to access message parameters,
+     and the match is based solely on the ID and notification code.
+
+     The supplied handler must be invocable with zero arguments: `handler()`.
+
+     Example:
+       on_command_notify_invoke<BN_CLICKED>(IDC_MY_BUTTON, my_signal);
+
+     Internally, this wraps the zero-argument handler inside a lambda that discards
+     the usual `HWND` and `command_params` parameters, providing a concise way to bind
+     simple actions to control notifications.
+  */
+  template<WORD NotifyCode, typename Handler>
+  requires std::invocable<Handler>
+  message_handler& on_command_notify_invoke(WORD id, Handler&& handler) {
+    return on_command_notify<NotifyCode>(id, [handler = std::forward<Handler>(handler)](HWND, auto&) mutable {
+        std::invoke(handler);
+      });
+  }
+
+  /*
+     Registers a message handler for an inclusive range of message IDs, such as a block
+     of WM_APP messages used by a custom protocol.
+
+     Because the exact message is only known at runtime, the handler receives the message
+     ID along with the generic `message_params`. Range handlers are consulted after any
+     handler registered for the exact message ID; lookup is a binary search over the
+     disjoint segments formed by all registered ranges.
+
+     Example:
+       handler.on_message_range<WM_APP, WM_APP + 0x0F>([](HWND hwnd, UINT msg, message_params& params) {
+         // handle WM_APP .. WM_APP + 0x0F
+       });
+
+     The handler must be invocable as: handler(HWND, UINT, message_params&)
+  */
+  template<UINT First, UINT Last, typename Handler, typename Filter = no_filter>
+  requires (First <= Last) && std::invocable<Handler, HWND, UINT, message_params&>
+  message_handler& on_message_range(Handler&& handler, Filter filter = {}) {
+    using handler_result_type = std::invoke_result_t<Handler, HWND, UINT, message_params&>;
+
+    range_handlers_.push_back({First, Last, [handler = std::forward<Handler>(handler), filter = std::move(filter)](HWND hwnd, UINT msg, message_params& params) mutable -> std::optional<LRESULT> {
+        if (!filter.matches(params))
+          return std::nullopt;
+
+        if constexpr (std::is_same_v<handler_result_type, void>) {
+          handler(hwnd, msg, params);
+          return 0; // auto-return 0 if handler returns void
+        } else {
+          return handler(hwnd, msg, params);
+        }
+      }});
+
+    rebuild_range_segments();
+
+    return *this;
+  }
+
+  /*
+     Registers a message handler for a message obtained from RegisterWindowMessageW.
+
+     The message is registered immediately and its handlers are stored in a dense array
+     indexed from the start of the registered message range (0xC000), so dispatch does not
+     depend on how many registered messages are in use.
+
+     Example:
+       handler.on_registered_message(L"MyApp.Refresh", [](HWND hwnd, message_params& params) {
+         // handle the registered message
+       });
+
+     The handler must be invocable as: handler(HWND, message_params&)
+  */
+  template<typename Handler, typename Filter = no_filter>
+  requires std::invocable<Handler, HWND, message_params&>
+  message_handler& on_registered_message(const wchar_t* name, Handler&& handler, Filter filter = {}) {
+    using handler_result_type = std::invoke_result_t<Handler, HWND, message_params&>;
+
+    auto msg = RegisterWindowMessageW(name);
+    if (!msg)
+      throw std::system_error(static_cast<int>(GetLastError()), std::system_category());
+
+    add_registered_handler(msg, [handler = std::forward<Handler>(handler), filter = std::move(filter)](HWND hwnd, message_params& params) mutable -> std::optional<LRESULT> {
+        if (!filter.matches(params))
+          return std::nullopt;
+
+        if constexpr (std::is_same_v<handler_result_type, void>) {
+          handler(hwnd, params);
+          return 0; // auto-return 0 if handler returns void
+        } else {
+          return handler(hwnd, params);
+        }
+      });
+
+    return *this;
+  }
+
+  /*
+     Registers a handler for a typed `custom_message` posted with `Message::post`.
+
+     The handler takes ownership of the pooled payload. It may either accept the payload
+     by reference, in which case the payload is released when the handler returns, or accept
+     `Message::pointer` to keep the payload alive beyond the handler.
+
+     Payloads of messages still queued when the window is destroyed are released by the
+     dispatcher on WM_NCDESTROY.
+
+     Examples:
+       handler.on_custom_message<progress_message>([](HWND hwnd, progress& p) {
+         // p is released on return
+       });
+       handler.on_custom_message<result_message>([this](HWND, result_message::pointer p) {
+         results_.push_back(std::move(p));
+       });
+  */
+  template<typename Message, typename Handler>
+  message_handler& on_custom_message(Handler&& handler) {
+    using payload_type = typename Message::payload_type;
+    using pointer = typename Message::pointer;
+
+    add_registered_handler(Message::id(), [handler = std::forward<Handler>(handler)](HWND hwnd, message_params& params) mutable -> std::optional<LRESULT> {
+        auto payload = Message::take(params);
+
+        if constexpr (std::invocable<Handler, HWND, pointer>) {
+          using handler_result_type = std::invoke_result_t<Handler, HWND, pointer>;
+          if constexpr (std::is_same_v<handler_result_type, void>) {
+            handler(hwnd, std::move(payload));
+            return 0; // auto-return 0 if handler returns void
+          } else {
+            return handler(hwnd, std::move(payload));
+          }
+        } else {
+          using handler_result_type = std::invoke_result_t<Handler, HWND, payload_type&>;
+          if constexpr (std::is_same_v<handler_result_type, void>) {
+            handler(hwnd, *payload);
+            return 0; // auto-return 0 if handler returns void
+          } else {
+            return handler(hwnd, *payload);
+          }
+        }
+      });
+
+    auto discard = &Message::discard_pending;
+    if (std::find(pending_discarders_.begin(), pending_discarders_.end(), discard) == pending_discarders_.end())
+      pending_discarders_.push_back(discard);
+
+    return *this;
+  }
+
+  /*
+     Enables reflection of control notifications for the window this handler is attached to.
+
+     When enabled, the dispatcher routes WM_COMMAND, WM_NOTIFY and WM_CTLCOLOR* messages
+     sent by a wndkit-registered child straight to that child's message handler as
+     `reflected_message(Msg)`. Only if the child does not handle the reflected message is
+     the original message passed to this handler.
+
+     Example:
+       parent_handler.reflect_notifications();
+       child_handler.on_message<reflected_message(WM_CTLCOLORSTATIC)>([](HWND, auto& params) {
+         SetBkMode(params.hdc(), TRANSPARENT);
+         return reinterpret_cast<LRESULT>(GetSysColorBrush(COLOR_WINDOW));
+       });
+  */
+  message_handler& reflect_notifications(bool enable = true) {
+    reflect_notifications_ = enable;
+    return *this;
+  }
+
+  bool reflects_notifications() const {
+    return reflect_notifications_;
+  }
+
+  /*
+     Releases the payloads of custom messages still queued for a window that is being destroyed.
+     Called by the dispatcher on WM_NCDESTROY.
+  */
+  void discard_pending_messages(HWND hwnd) const {
+    for (auto discard : pending_discarders_)
+      discard(hwnd);
+  }
+
+  /*
+     Dispatches a Windows message to a matching registered handler.
+
+     Parameters:
+       hwnd   - Handle to the window receiving the message.
+       msg    - The message ID (e.g., WM_PAINT, WM_COMMAND).
+       wparam - Additional message-specific information.
+       lparam - Additional message-specific information.
+
+     Returns:
+       An `std::optional<LRESULT>` containing the result of the first handler
+       that returns a value, or `std::nullopt` if no handler returns a value.
+  */
+  std::optional<LRESULT> call_handler(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam) const {
+    message_params params{wparam, lparam};
+
+    auto it = handlers_.find(msg);
+    if (it != handlers_.end()) {
+      for (const auto& callback : it->second)
+        if (auto result = callback(hwnd, params))
+          return result;
+    }
+
+    if (msg >= registered_message_first) {
+      auto index = static_cast<size_t>(msg - registered_message_first);
+      if (index < registered_handlers_.size()) {
+        for (const auto& callback : registered_handlers_[index])
+          if (auto result = callback(hwnd, params))
+            return result;
+      }
+    }
+
+    if (!range_segments_.empty()) {
+      // find the last segment starting at or before msg
+      auto segment = std::upper_bound(range_segments_.begin(), range_segments_.end(), msg, [](UINT value, const range_segment& segment) {
+          return value < segment.first;
+        });
+
+      if (segment != range_segments_.begin() && msg <= (--segment)->last) {
+        for (auto index : segment->handlers)
+          if (auto result = range_handlers_[index].callback(hwnd, msg, params))
+            return result;
+      }
+    }
+
+    return std::nullopt;
+  }
+
+private:
+  using handler_fn = std::function<std::optional<LRESULT>(HWND, message_params&)>;
+  using range_handler_fn = std::function<std::optional<LRESULT>(HWND, UINT, message_params&)>;
+
+  // RegisterWindowMessage returns IDs in the range 0xC000 through 0xFFFF
+  static constexpr UINT registered_message_first = 0xC000;
+
+  struct range_handler {
+    UINT first;
+    UINT last;
+    range_handler_fn callback;
+  };
+
+  // a run of message IDs covered by the same set of range handlers
+  struct range_segment {
+    UINT first;
+    UINT last;
+    std::vector<size_t> handlers; // indexes into range_handlers_, in registration order
+  };
+
+  void add_registered_handler(UINT msg, handler_fn handler) {
+    assert(msg >= registered_message_first);
+
+    auto index = static_cast<size_t>(msg - registered_message_first);
+    if (index >= registered_handlers_.size())
+      registered_handlers_.resize(index + 1);
+
+    registered_handlers_[index].push_back(std::move(handler));
+  }
+
+  // splits the (possibly overlapping) registered ranges into sorted, disjoint segments
+  void rebuild_range_segments() {
+    std::vector<UINT> bounds;
+    for (const auto& range : range_handlers_) {
+      bounds.push_back(range.first);
+      if (range.last != std::numeric_limits<UINT>::max())
+        bounds.push_back(range.last + 1);
+    }
+
+    std::sort(bounds.begin(), bounds.end());
+    bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+    range_segments_.clear();
+    for (size_t i = 0; i < bounds.size(); ++i) {
+      range_segment segment{bounds[i], i + 1 < bounds.size() ? bounds[i + 1] - 1 : std::numeric_limits<UINT>::max(), {}};
+
+      for (size_t index = 0; index < range_handlers_.size(); ++index) {
+        const auto& range = range_handlers_[index];
+        if (range.first <= segment.first && segment.last <= range.last)
+          segment.handlers.push_back(index);
+      }
+
+      if (!segment.handlers.empty())
+        range_segments_.push_back(std::move(segment));
+    }
+  }
+
+  std::unordered_map<UINT, std::vector<handler_fn>> handlers_;
+  std::vector<std::vector<handler_fn>> registered_handlers_;
+  std::vector<range_handler> range_handlers_;
+  std::vector<range_segment> range_segments_;
+  std::vector<void(*)(HWND)> pending_discarders_;
+  bool reflect_notifications_{};
+};
+
+}
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <windows.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <system_error>
+#include <thread>
+#include <wil/resource.h>
+#include <wndkit/custom_message.hpp>
+#include <wndkit/dispatcher.hpp>
+#include <wndkit/message_handler.hpp>
+#include "core/render_queue.hpp"
+
+namespace wndkit::widgets {
+
+/*
+   A window whose content is rendered on a worker thread.
+
+   For widgets that take too long to paint in WM_PAINT (charts, heatmaps): a derived class
+   implements `render`, which draws a frame into a 32-bit DIB section on the canvas's
+   worker thread. When a frame is done, the worker posts a message (a `custom_message`)
+   to the window, which repaints by copying the latest completed frame; WM_PAINT never
+   waits for rendering. Resizing, or calling `invalidate_content`, asks for a new frame;
+   requests made while a frame is rendering are coalesced, and a frame that is replaced
+   before it is shown is dropped (see `core::render_queue`).
+
+   `render` runs on the worker thread, so it must only use data it can safely read there.
+   The worker stops when the window is destroyed; a derived class destroyed before its
+   window must call `stop_rendering` from its destructor.
+*/
+class async_canvas {
+public:
+  // what a frame is rendered for
+  struct render_request {
+    int32_t width{};
+    int32_t height{};
+    UINT dpi{};
+  };
+
+  async_canvas() = default;
+
+  async_canvas(const async_canvas&) = delete;
+  async_canvas& operator=(const async_canvas&) = delete;
+
+  virtual ~async_canvas() {
+    stop_rendering();
+  }
+
+  static constexpr const wchar_t* class_name() {
+    return L"wndkit_async_canvas";
+  }
+
+  HWND create(HWND parent, int x, int y, int width, int height, HINSTANCE instance) {
+    message_handler_
+      .on_message<WM_SIZE>([this](HWND, const auto&) { invalidate_content(); })
+      .on_message<WM_PAINT>([this](HWND, const auto&) { on_paint(); })
+      .on_message<WM_ERASEBKGND>([](HWND, const auto&) { return TRUE; }) // every pixel is painted by on_paint
+      .on_message<WM_DESTROY>([this](HWND, const auto&) { stop_rendering(); })
+      .on_custom_message<frame_ready_message>([this](HWND, const auto&) { InvalidateRect(hwnd_, nullptr, FALSE); })
+    ;
+
+    hwnd_ = wndkit::dispatcher::create_window(&message_handler_,
+      0,
+      class_name(),
+      nullptr,
+      WS_CHILD | WS_VISIBLE,
+      x, y, width, height,
+      parent, nullptr,
+      instance, nullptr);
+    if (!hwnd_)
+      throw std::system_error(static_cast<int>(GetLastError()), std::system_category());
+
+    worker_ = std::thread([this] { run_worker(); });
+    invalidate_content();
+
+    return hwnd_;
+  }
+
+  // asks for a new frame (for example after the data shown changed); the current frame is shown until it is ready
+  void invalidate_content() {
+    if (!hwnd_ || !worker_.joinable())
+      return;
+
+    RECT client{};
+    GetClientRect(hwnd_, &client);
+    queue_.request({client.right - client.left, client.bottom - client.top, GetDpiForWindow(hwnd_)});
+  }
+
+  // stops the worker thread, waiting for a frame being rendered; no frames are rendered after this
+  void stop_rendering() {
+    queue_.stop();
+    if (worker_.joinable())
+      worker_.join();
+
+    if (hwnd_)
+      frame_ready_message::discard_pending(hwnd_);
+  }
+
+  // the counts of frames requested, coalesced, completed and dropped
+  auto stats() const {
+    return queue_.stats();
+  }
+
+  static ATOM register_class(HINSTANCE instance) {
+    WNDCLASSW wc{};
+    wc.lpfnWndProc   = wndkit::dispatcher::window_proc;
+    wc.hCursor       = LoadCursorW(nullptr, reinterpret_cast<LPCWSTR>(IDC_ARROW));
+    wc.hInstance     = instance;
+    wc.lpszClassName = class_name();
+
+    auto atom = RegisterClassW(&wc);
+    if (!atom)
+      throw std::system_error(static_cast<int>(GetLastError()), std::system_category());
+
+    return atom;
+  }
+
+protected:
+  /*
+     Draws a frame, on the worker thread. `hdc` has a top-down 32-bit DIB section of
+     `request.width` x `request.height` selected, with undefined contents; `pixels` points
+     at its bits (4 bytes per pixel, rows of `request.width` pixels).
+
+     Returns false to drop the frame, such as when `superseded()` reports that a newer
+     frame was requested part way through a long render.
+  */
+  virtual bool render(HDC hdc, void* pixels, const render_request& request) = 0;
+
+  // true if the frame being rendered is no longer needed; long renders can check this and give up
+  bool superseded() const {
+    return queue_.superseded(rendering_generation_);
+  }
+
+  // the color shown where no frame has been rendered yet
+  virtual HBRUSH background() const {
+    return reinterpret_cast<HBRUSH>(COLOR_WINDOW + 1);
+  }
+
+  HWND hwnd() const {
+    return hwnd_;
+  }
+
+private:
+  struct frame_ready {};
+  using frame_ready_message = custom_message<frame_ready, async_canvas>;
+
+  // a DIB section; only the worker thread touches a buffer it is rendering, only the UI thread the one shown
+  struct frame_buffer {
+    wil::unique_hbitmap bitmap;
+    void* pixels{};
+    int32_t width{};
+    int32_t height{};
+  };
+
+  void run_worker() {
+    wil::unique_hdc dc(CreateCompatibleDC(nullptr));
+
+    while (auto job = queue_.wait()) {
+      rendering_generation_ = job->generation;
+
+      auto& buffer = buffers_[job->buffer];
+      if (!dc || !prepare(buffer, job->request)) {
+        queue_.abandon(*job);
+        continue;
+      }
+
+      auto old_bitmap = SelectObject(dc.get(), buffer.bitmap.get());
+      auto rendered = render(dc.get(), buffer.pixels, job->request);
+      GdiFlush();
+      SelectObject(dc.get(), old_bitmap);
+
+      if (!rendered) {
+        queue_.abandon(*job);
+        continue;
+      }
+
+      if (queue_.complete(*job))
+        frame_ready_message::post(hwnd_);
+    }
+  }
+
+  // (re)creates the buffer's DIB section if it is not the requested size
+  static bool prepare(frame_buffer& buffer, const render_request& request) {
+    if (request.width <= 0 || request.height <= 0)
+      return false;
+    if (buffer.bitmap && buffer.width == request.width && buffer.height == request.height)
+      return true;
+
+    BITMAPINFO info{};
+    info.bmiHeader.biSize        = sizeof(info.bmiHeader);
+    info.bmiHeader.biWidth       = request.width;
+    info.bmiHeader.biHeight      = -request.height; // top-down
+    info.bmiHeader.biPlanes      = 1;
+    info.bmiHeader.biBitCount    = 32;
+    info.bmiHeader.biCompression = BI_RGB;
+
+    buffer = {};
+    buffer.bitmap.reset(CreateDIBSection(nullptr, &info, DIB_RGB_COLORS, &buffer.pixels, nullptr, 0));
+    if (!buffer.bitmap)
+      return false;
+
+    buffer.width = request.width;
+    buffer.height = request.height;
+    return true;
+  }
+
+  void on_paint() {
+    PAINTSTRUCT ps{};
+    auto hdc = wil::BeginPaint(hwnd_, &ps);
+
+    RECT client{};
+    GetClientRect(hwnd_, &client);
+
+    RECT covered{};
+    if (auto frame = queue_.present()) {
+      const auto& buffer = buffers_[frame->buffer];
+
+      wil::unique_hdc source(CreateCompatibleDC(hdc.get()));
+      if (source) {
+        auto old_bitmap = wil::SelectObject(source.get(), buffer.bitmap.get());
+        BitBlt(hdc.get(), 0, 0, buffer.width, buffer.height, source.get(), 0, 0, SRCCOPY);
+        covered = {0, 0, buffer.width, buffer.height};
+      }
+    }
+
+    // while a larger frame is being rendered, the rest of the window shows the background
+    RECT right{covered.right, 0, client.right, client.bottom};
+    RECT below{0, covered.bottom, std::min(covered.right, client.right), client.bottom};
+    if (!IsRectEmpty(&right))
+      FillRect(hdc.get(), &right, background());
+    if (!IsRectEmpty(&below))
+      FillRect(hdc.get(), &below, background());
+  }
+
+  wndkit::message_handler message_handler_;
+
+  HWND hwnd_{};
+  core::render_queue<render_request> queue_;
+  std::array<frame_buffer, core::render_queue<render_request>::buffer_count> buffers_;
+  std::thread worker_;
+  uint64_t rendering_generation_{}; // only used on the worker thread
+};
+
+}
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <windows.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <wil/resource.h>
+
+namespace wndkit::widgets {
+
+/*
+   Offscreen bitmaps reused across WM_PAINTs.
+
+   A buffer is a memory DC with a bitmap selected. Buffers are rounded up in size so a
+   slightly larger dirty region does not need a new bitmap, and are returned to the pool
+   after each paint. GDI objects belong to the thread that uses them, so every thread has
+   its own pool (see `for_thread`).
+*/
+class paint_buffer_pool {
+public:
+  struct buffer {
+    wil::unique_hdc dc;
+    wil::unique_hbitmap bitmap;
+    HGDIOBJ old_bitmap{};
+    SIZE size{};
+    int saved_state{};  // the DC state to restore when the buffer is returned
+
+    ~buffer() {
+      if (dc && old_bitmap)
+        SelectObject(dc.get(), old_bitmap);
+    }
+  };
+
+  paint_buffer_pool() = default;
+
+  paint_buffer_pool(const paint_buffer_pool&) = delete;
+  paint_buffer_pool& operator=(const paint_buffer_pool&) = delete;
+
+  static paint_buffer_pool& for_thread() {
+    thread_local paint_buffer_pool pool;
+    return pool;
+  }
+
+  // a buffer at least `width` x `height` compatible with `reference`, or null if GDI is out of resources
+  std::unique_ptr<buffer> acquire(HDC reference, int width, int height) {
+    auto it = std::find_if(free_.begin(), free_.end(), [&](const auto& buffer) {
+      return buffer->size.cx >= width && buffer->size.cy >= height;
+    });
+
+    std::unique_ptr<buffer> result;
+    if (it != free_.end()) {
+      result = std::move(*it);
+      free_.erase(it);
+    } else {
+      result = create(reference, round_up(width), round_up(height));
+      if (!result)
+        return nullptr;
+    }
+
+    result->saved_state = SaveDC(result->dc.get());
+    return result;
+  }
+
+  // returns a buffer with the DC state it was acquired with; the largest buffers are kept
+  void release(std::unique_ptr<buffer> buffer) {
+    if (!buffer)
+      return;
+
+    RestoreDC(buffer->dc.get(), buffer->saved_state);
+    free_.push_back(std::move(buffer));
+
+    if (free_.size() > max_free) {
+      auto smallest = std::min_element(free_.begin(), free_.end(), [](const auto& a, const auto& b) {
+        return int64_t{a->size.cx} * a->size.cy < int64_t{b->size.cx} * b->size.cy;
+      });
+      free_.erase(smallest);
+    }
+  }
+
+  // frees the pooled bitmaps (for example when the display settings change)
+  void clear() {
+    free_.clear();
+  }
+
+  size_t size() const {
+    return free_.size();
+  }
+
+private:
+  // buffers kept for reuse; more are only needed when paints nest
+  static constexpr size_t max_free = 2;
+
+  // buffer dimensions are multiples of this, so small changes in the dirty region reuse the buffer
+  static constexpr int granularity = 64;
+
+  static int round_up(int value) {
+    return (std::max(value, 1) + granularity - 1) / granularity * granularity;
+  }
+
+  static std::unique_ptr<buffer> create(HDC reference, int width, int height) {
+    auto result = std::make_unique<buffer>();
+    result->dc.reset(CreateCompatibleDC(reference));
+    if (!result->dc)
+      return nullptr;
+
+    result->bitmap.reset(CreateCompatibleBitmap(reference, width, height));
+    if (!result->bitmap)
+      return nullptr;
+
+    result->old_bitmap = SelectObject(result->dc.get(), result->bitmap.get());
+    result->size = {width, height};
+    return result;
+  }
+
+  std::vector<std::unique_ptr<buffer>> free_;
+};
+
+/*
+   Paints a window through an offscreen buffer.
+
+   Replaces BeginPaint/EndPaint in a WM_PAINT handler. `hdc()` is a pooled buffer the size
+   of the dirty rectangle, set up so that drawing uses client coordinates and is clipped to
+   the invalid region; when the object is destroyed, the dirty rectangle is copied to the
+   window in one BitBlt. The screen never shows a partly drawn frame, and nothing outside
+   the invalid region is drawn.
+
+   The buffer starts with undefined contents, so the window must paint its background
+   (see `fill`); invalidate with `bErase` set to FALSE, since WM_ERASEBKGND would paint
+   the screen directly. If no buffer can be made, `hdc()` is the window's paint DC.
+*/
+class buffered_paint {
+public:
+  explicit buffered_paint(HWND hwnd) {
+    // BeginPaint validates the window, so the invalid region has to be taken first
+    wil::unique_hrgn region(CreateRectRgn(0, 0, 0, 0));
+    auto has_region = region && GetUpdateRgn(hwnd, region.get(), FALSE) > NULLREGION;
+
+    paint_dc_ = wil::BeginPaint(hwnd, &ps_);
+
+    auto width = ps_.rcPaint.right - ps_.rcPaint.left;
+    auto height = ps_.rcPaint.bottom - ps_.rcPaint.top;
+    if (!paint_dc_ || width <= 0 || height <= 0)
+      return;
+
+    buffer_ = paint_buffer_pool::for_thread().acquire(paint_dc_.get(), width, height);
+    if (!buffer_)
+      return;
+
+    auto dc = buffer_->dc.get();
+
+    // drawing uses client coordinates; the buffer's origin is the dirty rectangle's corner
+    SetViewportOrgEx(dc, -ps_.rcPaint.left, -ps_.rcPaint.top, nullptr);
+
+    // the clip region is in device (buffer) coordinates
+    if (has_region) {
+      OffsetRgn(region.get(), -ps_.rcPaint.left, -ps_.rcPaint.top);
+      SelectClipRgn(dc, region.get());
+    } else {
+      IntersectClipRect(dc, 0, 0, width, height);
+    }
+
+    // the paint DC has the window's default font and colors; the buffer should too
+    SelectObject(dc, GetCurrentObject(paint_dc_.get(), OBJ_FONT));
+    SetTextColor(dc, GetTextColor(paint_dc_.get()));
+    SetBkColor(dc, GetBkColor(paint_dc_.get()));
+    SetBkMode(dc, GetBkMode(paint_dc_.get()));
+  }
+
+  buffered_paint(const buffered_paint&) = delete;
+  buffered_paint& operator=(const buffered_paint&) = delete;
+
+  ~buffered_paint() {
+    if (!buffer_)
+      return;
+
+    BitBlt(paint_dc_.get(),
+      ps_.rcPaint.left, ps_.rcPaint.top,
+      ps_.rcPaint.right - ps_.rcPaint.left, ps_.rcPaint.bottom - ps_.rcPaint.top,
+      buffer_->dc.get(), 0, 0, SRCCOPY);
+
+    paint_buffer_pool::for_thread().release(std::move(buffer_));
+  }
+
+  // the DC to draw with, in client coordinates
+  HDC hdc() const {
+    return buffer_ ? buffer_->dc.get() : paint_dc_.get();
+  }
+
+  // the bounds of the invalid region; drawing outside it is discarded
+  const RECT& dirty() const {
+    return ps_.rcPaint;
+  }
+
+  bool buffered() const {
+    return buffer_ != nullptr;
+  }
+
+  // fills the dirty rectangle, such as with the window's background
+  void fill(HBRUSH brush) const {
+    FillRect(hdc(), &ps_.rcPaint, brush);
+  }
+
+private:
+  PAINTSTRUCT ps_{};
+  wil::unique_hdc_paint paint_dc_;
+  std::unique_ptr<paint_buffer_pool::buffer> buffer_;
+};
+
+/*
+   Repaints part of a window when a piece of its state changes.
+
+   For state that only affects part of a window, such as a link's color when hovered:
+   `state` is set to `value` and, if that changed it, only `part` is invalidated, without
+   erasing (for windows painted with `buffered_paint`). Returns whether the state changed.
+*/
+template<typename T>
+bool update_part(HWND hwnd, T& state, const T& value, const RECT& part) {
+  if (state == value)
+    return false;
+
+  state = value;
+  if (hwnd && !IsRectEmpty(&part))
+    InvalidateRect(hwnd, &part, FALSE);
+
+  return true;
+}
+
+}
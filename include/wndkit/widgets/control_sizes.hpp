@@ -0,0 +1,138 @@
+#pragma once
+
+#include <windows.h>
+#include <commctrl.h>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace wndkit::widgets {
+
+/*
+   The default size (in dialog units) of controls added to a layout without a size.
+
+   Sizes are looked up by window class atom. A class registered by name is matched against
+   a window's class name only the first time a window of that class is seen; the atom is
+   remembered, so later lookups are a hash table lookup. Classes registered by atom (as
+   returned by RegisterClass) are never compared by name.
+
+   The table is shared by the whole process.
+*/
+class control_sizes {
+public:
+  // returns the default size of a window of the class, or nothing if it has none
+  using resolver = std::function<std::optional<SIZE>(HWND hwnd)>;
+
+  static control_sizes& instance() {
+    static control_sizes sizes;
+    return sizes;
+  }
+
+  control_sizes(const control_sizes&) = delete;
+  control_sizes& operator=(const control_sizes&) = delete;
+
+  // registers the default size of a window class by name (class names are not case sensitive)
+  void register_class(std::wstring class_name, resolver resolver) {
+    std::unique_lock lock(mutex_);
+    names_.emplace_back(std::move(class_name), std::make_shared<const control_sizes::resolver>(std::move(resolver)));
+
+    // classes that were not found may match the new name
+    std::erase_if(atoms_, [](const auto& entry) { return !entry.second; });
+  }
+
+  void register_class(std::wstring class_name, SIZE size_dlu) {
+    register_class(std::move(class_name), [size_dlu](HWND) { return std::optional<SIZE>{size_dlu}; });
+  }
+
+  // registers the default size of a window class by its atom
+  void register_class(ATOM atom, resolver resolver) {
+    std::unique_lock lock(mutex_);
+    atoms_[atom] = std::make_shared<const control_sizes::resolver>(std::move(resolver));
+  }
+
+  void register_class(ATOM atom, SIZE size_dlu) {
+    register_class(atom, [size_dlu](HWND) { return std::optional<SIZE>{size_dlu}; });
+  }
+
+  std::optional<SIZE> default_size(HWND hwnd) {
+    auto atom = static_cast<ATOM>(GetClassLongPtrW(hwnd, GCW_ATOM));
+    if (!atom)
+      return {};
+
+    std::shared_ptr<const resolver> found;
+    {
+      std::shared_lock lock(mutex_);
+      if (auto it = atoms_.find(atom); it != atoms_.end()) {
+        if (!it->second)
+          return {};
+        found = it->second;
+      }
+    }
+
+    if (!found)
+      found = learn(hwnd, atom);
+
+    // resolved outside the lock so a resolver may use the table
+    return found ? (*found)(hwnd) : std::nullopt;
+  }
+
+private:
+  control_sizes() {
+    register_class(WC_BUTTONW, [](HWND hwnd) -> std::optional<SIZE> {
+      auto style = static_cast<DWORD>(GetWindowLongPtr(hwnd, GWL_STYLE));
+      switch (style & 0xF) { // lower 4 bits are the BS_* type
+        case BS_CHECKBOX:
+        case BS_AUTOCHECKBOX:
+        case BS_3STATE:
+        case BS_AUTO3STATE:
+        case BS_RADIOBUTTON:
+        case BS_AUTORADIOBUTTON:
+          return SIZE{10, 10};
+
+        case BS_GROUPBOX:
+          return SIZE{50, 28};
+
+        default:
+          return SIZE{50, 14};
+      }
+    });
+    register_class(WC_EDITW, SIZE{50, 14});
+    register_class(WC_STATICW, SIZE{50, 8});
+    register_class(WC_LISTBOXW, SIZE{50, 50});
+    register_class(WC_SCROLLBARW, SIZE{16, 70});
+  }
+
+  // matches a class seen for the first time against the registered names and remembers its atom
+  std::shared_ptr<const resolver> learn(HWND hwnd, ATOM atom) {
+    wchar_t class_name[256];
+    auto length = GetClassNameW(hwnd, class_name, static_cast<int>(std::size(class_name)));
+
+    std::unique_lock lock(mutex_);
+    auto& found = atoms_[atom];
+    if (found)
+      return found; // registered by atom, or learnt by another thread
+
+    // the latest registration of a name wins
+    for (auto it = names_.rbegin(); it != names_.rend(); ++it) {
+      if (CompareStringOrdinal(class_name, length, it->first.c_str(), static_cast<int>(it->first.size()), TRUE) == CSTR_EQUAL) {
+        found = it->second;
+        break;
+      }
+    }
+
+    return found; // null is remembered too, so unknown classes are not compared again
+  }
+
+  std::shared_mutex mutex_;
+  std::vector<std::pair<std::wstring, std::shared_ptr<const resolver>>> names_;
+  std::unordered_map<ATOM, std::shared_ptr<const resolver>> atoms_;
+};
+
+}
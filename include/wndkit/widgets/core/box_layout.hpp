@@ -0,0 +1,241 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "layout.hpp"
+
+namespace wndkit::widgets::core {
+
+/*
+   Stacks items horizontally or vertically.
+
+   Items keep their size hint unless they have a stretch: any space left over along the
+   box's direction is shared between the stretched items in proportion to their stretch,
+   up to their maximum sizes, and when there is too little space they shrink the same way
+   down to their minimum sizes. Across the box's direction items keep their size hint and
+   are positioned by their alignment.
+
+   Sharing the space is a single pass over the items. Items that reach their limit first
+   are visited first; that order only changes with the items or the font, so it is cached
+   and the pass has no iterative relaxation.
+*/
+class box_layout : public layout {
+public:
+  enum class orientation {
+    horizontal,
+    vertical
+  };
+
+  explicit box_layout(orientation orientation)
+    : orientation_(orientation) {
+  }
+
+protected:
+  // returns the space that the layout will take up (in dialog units)
+  virtual size measure() const override {
+    // the preferred sizes (or the font) changed
+    order_valid_[false] = order_valid_[true] = false;
+
+    size size{margin_dlu_.cx * 2, margin_dlu_.cy * 2};
+    if (orientation_ == orientation::horizontal)
+      size.cx += static_cast<int32_t>(items_.size() - 1) * spacing_dlu_.cx;
+    else
+      size.cy += static_cast<int32_t>(items_.size() - 1) * spacing_dlu_.cy;
+
+    core::size total_items_size{};
+    for (const auto& item : items_) {
+      auto item_size = item->preferred_size();
+      if (orientation_ == orientation::horizontal) {
+        total_items_size.cx += item_size.cx;
+        if (item_size.cy > total_items_size.cy)
+          total_items_size.cy = item_size.cy;
+      } else {
+        total_items_size.cy += item_size.cy;
+        if (item_size.cx > total_items_size.cx)
+          total_items_size.cx = item_size.cx;
+      }
+    }
+
+    size.cx += total_items_size.cx;
+    size.cy += total_items_size.cy;
+
+    return size;
+  }
+
+  virtual void arrange(placement& placement, const rect& area) override {
+    auto margin = to_pixels(margin_dlu_);
+    auto spacing = to_pixels(spacing_dlu_);
+
+    calc_size(); // measures again if the items changed since the last arrange
+    distribute(area, margin, spacing);
+
+    int32_t item_x = area.left + margin.cx;
+    int32_t item_y = area.top + margin.cy;
+
+    for (size_t i = 0; i < items_.size(); ++i) {
+      const auto& item = items_[i];
+      auto item_size = item_sizes_[i];
+
+      auto aligned_x = item_x;
+      auto aligned_y = item_y;
+      if (orientation_ == orientation::horizontal) {
+        if (has_alignment(item->alignment(), alignment_flag::align_vcenter))
+          aligned_y = item_y + (area.height() - margin.cy - item_size.cy) / 2;
+        else if (has_alignment(item->alignment(), alignment_flag::align_bottom))
+          aligned_y = area.bottom - margin.cy - item_size.cy;
+
+        item_x += item_size.cx + spacing.cx;
+      } else {
+        if (has_alignment(item->alignment(), alignment_flag::align_hcenter))
+          aligned_x = item_x + (area.width() - margin.cx - item_size.cx) / 2;
+        else if (has_alignment(item->alignment(), alignment_flag::align_right))
+          aligned_x = area.right - margin.cx - item_size.cx;
+
+        item_y += item_size.cy + spacing.cy;
+      }
+
+      rect item_area{
+        aligned_x,
+        aligned_y,
+        aligned_x + item_size.cx,
+        aligned_y + item_size.cy
+      };
+
+      item->arrange(placement, item_area);
+    }
+  }
+
+  virtual bool compile_flat(flat_state& flat, int32_t parent, alignment_flag alignment) override {
+    // the flat engine only stacks items at their size hint
+    if (std::any_of(items_.begin(), items_.end(), [](const auto& item) { return item->is_flexible(); }))
+      return false;
+
+    auto kind = orientation_ == orientation::horizontal ? flat_layout::node_kind::hbox : flat_layout::node_kind::vbox;
+    auto node = flat.tree.add_box(parent, kind, alignment, margin_dlu_, spacing_dlu_);
+    flat.add_node({this, nullptr, nullptr});
+
+    for (const auto& item : items_)
+      item->compile_flat(flat, node);
+
+    return true;
+  }
+
+private:
+  struct flex_item {
+    size_t index;
+    int32_t stretch;
+    int32_t capacity; // how far the item can grow (or shrink) from its preferred size
+  };
+
+  int32_t& main_size(size& size) const {
+    return orientation_ == orientation::horizontal ? size.cx : size.cy;
+  }
+
+  int32_t main_size(const size& size) const {
+    return orientation_ == orientation::horizontal ? size.cx : size.cy;
+  }
+
+  // the limit of an item along the box's direction, in pixels
+  int32_t main_limit(int32_t limit_dlu) const {
+    if (limit_dlu == unbounded)
+      return unbounded;
+
+    return orientation_ == orientation::horizontal ? mul_div(limit_dlu, font_size_.cx, 4) : mul_div(limit_dlu, font_size_.cy, 8);
+  }
+
+  // sizes every item into item_sizes_ (in pixels)
+  void distribute(const rect& area, size margin, size spacing) {
+    auto count = items_.size();
+    item_sizes_.resize(count);
+
+    int64_t used = 0;
+    for (size_t i = 0; i < count; ++i) {
+      item_sizes_[i] = to_pixels(items_[i]->preferred_size());
+      used += main_size(item_sizes_[i]);
+    }
+
+    int64_t available = orientation_ == orientation::horizontal
+      ? area.width() - margin.cx * 2 - int64_t{spacing.cx} * (static_cast<int64_t>(count) - 1)
+      : area.height() - margin.cy * 2 - int64_t{spacing.cy} * (static_cast<int64_t>(count) - 1);
+
+    if (available > used)
+      share(available - used, true);
+    else if (available < used)
+      share(used - available, false);
+  }
+
+  // shares `amount` pixels between the stretched items, growing them if `grow` is set and shrinking them otherwise
+  void share(int64_t amount, bool grow) {
+    auto& order = grow ? grow_order_ : shrink_order_;
+    if (!order_valid_[grow])
+      sort_order(grow);
+
+    if (order.empty())
+      return;
+
+    int64_t total_stretch = 0;
+    for (const auto& flex : order)
+      total_stretch += flex.stretch;
+
+    // items whose share would take them past their limit are visited first; they get their full capacity
+    size_t next = 0;
+    for (; next < order.size(); ++next) {
+      const auto& flex = order[next];
+      if (int64_t{flex.stretch} * amount < int64_t{flex.capacity} * total_stretch)
+        break;
+
+      apply(flex.index, flex.capacity, grow);
+      amount -= flex.capacity;
+      total_stretch -= flex.stretch;
+    }
+
+    // the rest share what is left in proportion to their stretch, with the rounding spread so that it adds up
+    int64_t cumulative_stretch = 0;
+    int64_t given = 0;
+    for (; next < order.size(); ++next) {
+      const auto& flex = order[next];
+      cumulative_stretch += flex.stretch;
+      auto portion = cumulative_stretch * amount / total_stretch - given;
+      given += portion;
+      apply(flex.index, static_cast<int32_t>(std::min<int64_t>(portion, flex.capacity)), grow);
+    }
+  }
+
+  void apply(size_t index, int32_t amount, bool grow) {
+    main_size(item_sizes_[index]) += grow ? amount : -amount;
+  }
+
+  // orders the stretched items by how soon they reach their limit (capacity / stretch)
+  void sort_order(bool grow) {
+    auto& order = grow ? grow_order_ : shrink_order_;
+    order.clear();
+
+    for (size_t i = 0; i < items_.size(); ++i) {
+      const auto& options = items_[i]->options();
+      if (options.stretch <= 0)
+        continue;
+
+      auto limit = main_limit(main_size(grow ? options.max_dlu : options.min_dlu));
+      auto preferred = main_size(item_sizes_[i]);
+      auto capacity = grow ? int64_t{limit} - preferred : int64_t{preferred} - limit;
+      order.push_back({i, options.stretch, static_cast<int32_t>(std::clamp<int64_t>(capacity, 0, unbounded))});
+    }
+
+    std::sort(order.begin(), order.end(), [](const flex_item& lhs, const flex_item& rhs) {
+        return int64_t{lhs.capacity} * rhs.stretch < int64_t{rhs.capacity} * lhs.stretch;
+      });
+
+    order_valid_[grow] = true;
+  }
+
+  orientation orientation_;
+
+  // scratch space and cached orders for distribute
+  std::vector<size> item_sizes_;
+  std::vector<flex_item> grow_order_;
+  std::vector<flex_item> shrink_order_;
+  mutable bool order_valid_[2]{}; // indexed by grow; the orders are sorted again after each measure
+};
+
+}
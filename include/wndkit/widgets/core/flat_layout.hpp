@@ -0,0 +1,217 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "geometry.hpp"
+
+namespace wndkit::widgets::core {
+
+/*
+   A tree of box layouts compiled into flat arrays (structure of arrays).
+
+   Nodes are stored in pre-order, so every node follows its parent and precedes its
+   descendants. Measuring walks the arrays backwards, folding each node into its parent;
+   arranging walks them forwards, placing each node within its parent. Both passes are
+   linear, and the dialog unit to pixel conversion is a separate loop over contiguous
+   arrays that the compiler can vectorize.
+
+   Items are leaves with a fixed size (a widget, or a layout that is not a box). Boxes
+   take their size from their items.
+
+   This header has no Win32 dependencies.
+*/
+class flat_layout {
+public:
+  enum class node_kind : uint8_t {
+    item,
+    hbox,
+    vbox
+  };
+
+  void clear() {
+    parent_.clear();
+    kind_.clear();
+    alignment_.clear();
+    child_count_.clear();
+    cx_.clear();
+    cy_.clear();
+    margin_cx_.clear();
+    margin_cy_.clear();
+    spacing_cx_.clear();
+    spacing_cy_.clear();
+  }
+
+  int32_t node_count() const {
+    return static_cast<int32_t>(parent_.size());
+  }
+
+  void reserve(size_t count) {
+    for (auto array : {&parent_, &child_count_, &cx_, &cy_, &margin_cx_, &margin_cy_, &spacing_cx_, &spacing_cy_})
+      array->reserve(count);
+    kind_.reserve(count);
+    alignment_.reserve(count);
+  }
+
+  // appends a box; `parent` is -1 for the root. Sizes are in dialog units.
+  int32_t add_box(int32_t parent, node_kind kind, alignment_flag alignment, size margin, size spacing) {
+    return add_node(parent, kind, alignment, {}, margin, spacing);
+  }
+
+  // appends a leaf of a fixed size (in dialog units)
+  int32_t add_item(int32_t parent, alignment_flag alignment, size size_dlu) {
+    return add_node(parent, node_kind::item, alignment, size_dlu, {}, {});
+  }
+
+  // computes the size of every box (in dialog units) from its items
+  void measure() {
+    auto count = node_count();
+    for (int32_t i = 0; i < count; ++i) {
+      if (kind_[i] != node_kind::item)
+        cx_[i] = cy_[i] = 0;
+    }
+
+    // every descendant of a node has a larger index, so a box is complete when it is reached
+    for (int32_t i = count; i-- > 0;) {
+      auto kind = kind_[i];
+      if (kind == node_kind::hbox) {
+        cx_[i] += margin_cx_[i] * 2 + (child_count_[i] - 1) * spacing_cx_[i];
+        cy_[i] += margin_cy_[i] * 2;
+      } else if (kind == node_kind::vbox) {
+        cx_[i] += margin_cx_[i] * 2;
+        cy_[i] += margin_cy_[i] * 2 + (child_count_[i] - 1) * spacing_cy_[i];
+      }
+
+      auto p = parent_[i];
+      if (p < 0)
+        continue;
+
+      if (kind_[p] == node_kind::hbox) {
+        cx_[p] += cx_[i];
+        cy_[p] = std::max(cy_[p], cy_[i]);
+      } else {
+        cy_[p] += cy_[i];
+        cx_[p] = std::max(cx_[p], cx_[i]);
+      }
+    }
+  }
+
+  // the measured size of a node (in dialog units)
+  size measured_size(int32_t node) const {
+    return {cx_[node], cy_[node]};
+  }
+
+  // positions every node within `area` (in pixels), given the font's average character size
+  void arrange(const rect& area, size font_size) {
+    auto count = node_count();
+    to_pixels<4>(cx_, px_cx_, font_size.cx);
+    to_pixels<8>(cy_, px_cy_, font_size.cy);
+    to_pixels<4>(margin_cx_, px_margin_cx_, font_size.cx);
+    to_pixels<8>(margin_cy_, px_margin_cy_, font_size.cy);
+    to_pixels<4>(spacing_cx_, px_spacing_cx_, font_size.cx);
+    to_pixels<8>(spacing_cy_, px_spacing_cy_, font_size.cy);
+
+    rects_.resize(count);
+    pen_x_.resize(count);
+    pen_y_.resize(count);
+
+    for (int32_t i = 0; i < count; ++i) {
+      auto p = parent_[i];
+      if (p < 0) {
+        rects_[i] = area;
+      } else {
+        auto& parent_area = rects_[p];
+        auto x = pen_x_[p];
+        auto y = pen_y_[p];
+        auto alignment = alignment_[i];
+
+        if (kind_[p] == node_kind::hbox) {
+          if (has_alignment(alignment, alignment_flag::align_vcenter))
+            y += (parent_area.height() - px_margin_cy_[p] - px_cy_[i]) / 2;
+          else if (has_alignment(alignment, alignment_flag::align_bottom))
+            y = parent_area.bottom - px_margin_cy_[p] - px_cy_[i];
+
+          pen_x_[p] += px_cx_[i] + px_spacing_cx_[p];
+        } else {
+          if (has_alignment(alignment, alignment_flag::align_hcenter))
+            x += (parent_area.width() - px_margin_cx_[p] - px_cx_[i]) / 2;
+          else if (has_alignment(alignment, alignment_flag::align_right))
+            x = parent_area.right - px_margin_cx_[p] - px_cx_[i];
+
+          pen_y_[p] += px_cy_[i] + px_spacing_cy_[p];
+        }
+
+        rects_[i] = {x, y, x + px_cx_[i], y + px_cy_[i]};
+      }
+
+      if (kind_[i] != node_kind::item) {
+        pen_x_[i] = rects_[i].left + px_margin_cx_[i];
+        pen_y_[i] = rects_[i].top + px_margin_cy_[i];
+      }
+    }
+  }
+
+  node_kind kind(int32_t node) const {
+    return kind_[node];
+  }
+
+  // the area given to a node by the last arrange (in pixels)
+  const rect& arranged_rect(int32_t node) const {
+    return rects_[node];
+  }
+
+private:
+  int32_t add_node(int32_t parent, node_kind kind, alignment_flag alignment, size size_dlu, size margin, size spacing) {
+    auto index = node_count();
+    parent_.push_back(parent);
+    kind_.push_back(kind);
+    alignment_.push_back(alignment);
+    child_count_.push_back(0);
+    cx_.push_back(size_dlu.cx);
+    cy_.push_back(size_dlu.cy);
+    margin_cx_.push_back(margin.cx);
+    margin_cy_.push_back(margin.cy);
+    spacing_cx_.push_back(spacing.cx);
+    spacing_cy_.push_back(spacing.cy);
+
+    if (parent >= 0)
+      ++child_count_[parent];
+
+    return index;
+  }
+
+  // a dialog unit is a quarter of the average character width and an eighth of its height
+  template<int32_t Denominator>
+  static void to_pixels(const std::vector<int32_t>& dlu, std::vector<int32_t>& pixels, int32_t numerator) {
+    pixels.resize(dlu.size());
+    for (size_t i = 0; i < dlu.size(); ++i)
+      pixels[i] = mul_div(dlu[i], numerator, Denominator);
+  }
+
+  // structure
+  std::vector<int32_t> parent_;
+  std::vector<node_kind> kind_;
+  std::vector<alignment_flag> alignment_;
+  std::vector<int32_t> child_count_;
+
+  // sizes and box parameters (dialog units)
+  std::vector<int32_t> cx_;
+  std::vector<int32_t> cy_;
+  std::vector<int32_t> margin_cx_;
+  std::vector<int32_t> margin_cy_;
+  std::vector<int32_t> spacing_cx_;
+  std::vector<int32_t> spacing_cy_;
+
+  // arrange pass (pixels)
+  std::vector<int32_t> px_cx_;
+  std::vector<int32_t> px_cy_;
+  std::vector<int32_t> px_margin_cx_;
+  std::vector<int32_t> px_margin_cy_;
+  std::vector<int32_t> px_spacing_cx_;
+  std::vector<int32_t> px_spacing_cy_;
+  std::vector<int32_t> pen_x_;
+  std::vector<int32_t> pen_y_;
+  std::vector<rect> rects_;
+};
+
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <chrono>
+
+namespace wndkit::widgets::core {
+
+/*
+   Limits work (such as laying out a window being resized) to once per display frame.
+
+   Outside a paced period every request runs immediately. Between `begin` and `end`, a
+   request runs only if a frame interval has passed since the last run; otherwise it is
+   kept pending, and `tick` (called from a timer) reports when it is due. Pending requests
+   are coalesced, so the work always runs with the latest state. `end` reports whether
+   anything ran or was requested, so the caller can finish with an exact pass.
+
+   The time is passed in by the caller, so the pacing can be driven by a fake clock.
+   This header has no Win32 dependencies.
+*/
+class frame_pacer {
+public:
+  using clock = std::chrono::steady_clock;
+  using time_point = clock::time_point;
+  using duration = clock::duration;
+
+  static constexpr duration default_interval = std::chrono::microseconds(16667); // 60Hz
+
+  explicit frame_pacer(duration interval = default_interval) :
+    interval_(interval) {
+  }
+
+  void set_interval(duration interval) {
+    interval_ = interval;
+  }
+
+  duration interval() const {
+    return interval_;
+  }
+
+  // starts pacing requests
+  void begin() {
+    active_ = true;
+    pending_ = false;
+    requested_ = false;
+    last_run_ = {};
+  }
+
+  // stops pacing; returns true if anything was requested while paced
+  bool end() {
+    auto requested = requested_;
+    active_ = false;
+    pending_ = false;
+    requested_ = false;
+    return requested;
+  }
+
+  // returns true if the work should run now, false if it was deferred until `due()`
+  bool request(time_point now) {
+    if (!active_)
+      return true;
+
+    requested_ = true;
+    if (last_run_ == time_point{} || now - last_run_ >= interval_) {
+      ran(now);
+      return true;
+    }
+
+    pending_ = true;
+    return false;
+  }
+
+  // returns true if deferred work is due and should run now
+  bool tick(time_point now) {
+    if (!pending_ || now < due())
+      return false;
+
+    ran(now);
+    return true;
+  }
+
+  bool active() const {
+    return active_;
+  }
+
+  bool pending() const {
+    return pending_;
+  }
+
+  // when deferred work becomes due
+  time_point due() const {
+    return last_run_ + interval_;
+  }
+
+private:
+  void ran(time_point now) {
+    last_run_ = now;
+    pending_ = false;
+  }
+
+  duration interval_;
+  time_point last_run_{};
+  bool active_{};
+  bool pending_{};
+  bool requested_{};
+};
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace wndkit::widgets::core {
+
+// window-system independent counterparts of SIZE and RECT
+struct size {
+  int32_t cx{};
+  int32_t cy{};
+
+  friend constexpr bool operator==(const size&, const size&) = default;
+};
+
+struct rect {
+  int32_t left{};
+  int32_t top{};
+  int32_t right{};
+  int32_t bottom{};
+
+  constexpr int32_t width() const { return right - left; }
+  constexpr int32_t height() const { return bottom - top; }
+
+  friend constexpr bool operator==(const rect&, const rect&) = default;
+};
+
+// rounds to the nearest integer like MulDiv, without its overflow check
+constexpr int32_t mul_div(int32_t number, int32_t numerator, int32_t denominator) noexcept {
+  auto product = int64_t{number} * numerator;
+  auto half = denominator / 2;
+  return static_cast<int32_t>(product >= 0 ? (product + half) / denominator : (product - half) / denominator);
+}
+
+enum class alignment_flag : uint32_t {
+  none          = 0x0,
+  align_left    = 0x1,
+  align_right   = 0x2,
+  align_hcenter = 0x4,
+  align_top     = 0x8,
+  align_bottom  = 0x10,
+  align_vcenter = 0x20,
+  align_center  = align_hcenter | align_vcenter
+};
+
+constexpr alignment_flag operator|(alignment_flag lhs, alignment_flag rhs) noexcept {
+  using utype = std::underlying_type_t<alignment_flag>;
+  return static_cast<alignment_flag>(
+    static_cast<utype>(lhs) | static_cast<utype>(rhs)
+  );
+}
+
+constexpr alignment_flag operator&(alignment_flag lhs, alignment_flag rhs) noexcept {
+  using utype = std::underlying_type_t<alignment_flag>;
+  return static_cast<alignment_flag>(
+    static_cast<utype>(lhs) & static_cast<utype>(rhs)
+  );
+}
+
+constexpr bool has_alignment(alignment_flag flags, alignment_flag test) noexcept {
+  return (flags & test) == test;
+}
+
+}
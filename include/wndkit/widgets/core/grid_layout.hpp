@@ -0,0 +1,387 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "layout.hpp"
+
+namespace wndkit::widgets::core {
+
+// how a row or column of a grid is sized
+struct grid_track {
+  enum class sizing {
+    automatic, // fits the largest item in the track
+    fixed,     // `value` dialog units
+    star       // a `value` weighted share of the space left by the other tracks
+  };
+
+  sizing kind{sizing::automatic};
+  int32_t value{};
+
+  static constexpr grid_track automatic() {
+    return {sizing::automatic, 0};
+  }
+
+  static constexpr grid_track fixed(int32_t size_dlu) {
+    return {sizing::fixed, size_dlu};
+  }
+
+  static constexpr grid_track star(int32_t weight = 1) {
+    return {sizing::star, weight};
+  }
+};
+
+// the cells an item covers
+struct grid_cell {
+  int32_t row{};
+  int32_t column{};
+  int32_t row_span{1};
+  int32_t column_span{1};
+};
+
+/*
+   Arranges items in rows and columns.
+
+   An item covers one cell or spans several. Items with no horizontal (or vertical)
+   alignment fill their cells in that direction; otherwise they keep their size hint and
+   are aligned within the cells. Items added without a cell (through the `layout` API) go
+   in the cell after the previous item, row by row. Rows and columns beyond those defined
+   are sized automatically.
+
+   The content size of each track is cached. When the grid is measured again only the
+   tracks holding an item whose size changed are recomputed, and the track positions are
+   only recomputed when the grid's size, the font or the content changes.
+*/
+class grid_layout : public layout {
+public:
+  using track = grid_track;
+  using cell = grid_cell;
+
+  grid_layout(std::vector<track> columns, std::vector<track> rows) {
+    tracks_[column_axis].definitions = std::move(columns);
+    tracks_[row_axis].definitions = std::move(rows);
+  }
+
+  grid_layout& add_widget(item_handle item, const cell& cell, alignment_flag align, size size_dlu, const item_options& options = {}) {
+    layout::add_widget(item, align, size_dlu, options);
+    set_cell(cell);
+    return *this;
+  }
+
+  grid_layout& add_widget(item_handle item, const cell& cell, alignment_flag align, metrics_provider& metrics, const item_options& options = {}) {
+    layout::add_widget(item, align, metrics, options);
+    set_cell(cell);
+    return *this;
+  }
+
+  grid_layout& add_layout(std::unique_ptr<layout> layout, const cell& cell, alignment_flag align = alignment_flag::none, const item_options& options = {}) {
+    layout::add_layout(std::move(layout), align, options);
+    set_cell(cell);
+    return *this;
+  }
+
+  using layout::add_widget;
+  using layout::add_layout;
+
+  void set_columns(std::vector<track> columns) {
+    set_tracks(column_axis, std::move(columns));
+  }
+
+  void set_rows(std::vector<track> rows) {
+    set_tracks(row_axis, std::move(rows));
+  }
+
+protected:
+  virtual size measure() const override {
+    index_items();
+
+    // only the tracks holding an item whose size changed are recomputed
+    auto count = items_.size();
+    for (size_t i = 0; i < count; ++i) {
+      auto item_size = items_[i]->preferred_size();
+      if (item_size == item_sizes_[i])
+        continue;
+
+      item_sizes_[i] = item_size;
+      for (auto axis : {column_axis, row_axis}) {
+        auto [first, span] = extent(cells_[i], axis);
+        if (span == 1)
+          tracks_[axis].dirty[first] = true;
+      }
+    }
+
+    size size{};
+    for (auto axis : {column_axis, row_axis}) {
+      auto& tracks = tracks_[axis];
+      auto track_count = tracks.content.size();
+
+      for (size_t t = 0; t < track_count; ++t) {
+        if (!tracks.dirty[t])
+          continue;
+
+        int32_t content = 0;
+        for (auto i : tracks.items[t])
+          content = std::max(content, along(item_sizes_[i], axis));
+
+        tracks.content[t] = content;
+        tracks.dirty[t] = false;
+      }
+
+      for (size_t t = 0; t < track_count; ++t)
+        tracks.measured[t] = definition(axis, t).kind == track::sizing::fixed ? definition(axis, t).value : tracks.content[t];
+
+      // a spanning item widens the last flexible track it covers by whatever it is missing
+      auto spacing = along(spacing_dlu_, axis);
+      for (auto i : tracks.spanning) {
+        auto [first, span] = extent(cells_[i], axis);
+        auto covered = spacing * (span - 1);
+        auto widen = first + span - 1;
+        for (auto t = first; t < first + span; ++t) {
+          covered += tracks.measured[t];
+          if (definition(axis, t).kind != track::sizing::fixed)
+            widen = t;
+        }
+
+        auto missing = along(item_sizes_[i], axis) - covered;
+        if (missing > 0)
+          tracks.measured[widen] += missing;
+      }
+
+      int32_t total = along(margin_dlu_, axis) * 2;
+      for (auto measured : tracks.measured)
+        total += measured;
+      if (track_count > 0)
+        total += spacing * static_cast<int32_t>(track_count - 1);
+
+      along(size, axis) = total;
+    }
+
+    // the track positions depend on the measured sizes
+    arranged_valid_ = false;
+
+    return size;
+  }
+
+  virtual void arrange(placement& placement, const rect& area) override {
+    calc_size(); // measures again if the items changed since the last arrange
+
+    auto extent_size = size{area.width(), area.height()};
+    if (!arranged_valid_ || arranged_extent_ != extent_size || arranged_font_ != font_size_) {
+      position_tracks(column_axis, area.width());
+      position_tracks(row_axis, area.height());
+      arranged_valid_ = true;
+      arranged_extent_ = extent_size;
+      arranged_font_ = font_size_;
+    }
+
+    auto spacing = to_pixels(spacing_dlu_);
+    auto margin = to_pixels(margin_dlu_);
+
+    for (size_t i = 0; i < items_.size(); ++i) {
+      const auto& item = items_[i];
+      auto [first_column, column_span] = extent(cells_[i], column_axis);
+      auto [first_row, row_span] = extent(cells_[i], row_axis);
+
+      auto& columns = tracks_[column_axis];
+      auto& rows = tracks_[row_axis];
+      rect cell_area{
+        area.left + margin.cx + columns.offsets[first_column],
+        area.top + margin.cy + rows.offsets[first_row],
+        area.left + margin.cx + columns.offsets[first_column + column_span] - spacing.cx,
+        area.top + margin.cy + rows.offsets[first_row + row_span] - spacing.cy
+      };
+
+      auto item_size = to_pixels(item_sizes_[i]);
+      auto alignment = item->alignment();
+      auto item_area = cell_area;
+
+      auto horizontal = alignment & (alignment_flag::align_left | alignment_flag::align_right | alignment_flag::align_hcenter);
+      if (has_alignment(alignment, alignment_flag::align_hcenter))
+        item_area.left += (cell_area.width() - item_size.cx) / 2;
+      else if (has_alignment(alignment, alignment_flag::align_right))
+        item_area.left = cell_area.right - item_size.cx;
+      if (horizontal != alignment_flag::none)
+        item_area.right = item_area.left + item_size.cx;
+      else if (item->options().max_dlu.cx != unbounded)
+        item_area.right = item_area.left + std::min(cell_area.width(), to_pixels(item->options().max_dlu).cx);
+
+      auto vertical = alignment & (alignment_flag::align_top | alignment_flag::align_bottom | alignment_flag::align_vcenter);
+      if (has_alignment(alignment, alignment_flag::align_vcenter))
+        item_area.top += (cell_area.height() - item_size.cy) / 2;
+      else if (has_alignment(alignment, alignment_flag::align_bottom))
+        item_area.top = cell_area.bottom - item_size.cy;
+      if (vertical != alignment_flag::none)
+        item_area.bottom = item_area.top + item_size.cy;
+      else if (item->options().max_dlu.cy != unbounded)
+        item_area.bottom = item_area.top + std::min(cell_area.height(), to_pixels(item->options().max_dlu).cy);
+
+      item->arrange(placement, item_area);
+    }
+  }
+
+  void item_removed(size_t index) override {
+    if (index < cells_.size())
+      cells_.erase(cells_.begin() + static_cast<ptrdiff_t>(index));
+
+    // the track indexes hold item positions, so they are rebuilt
+    indexed_count_ = 0;
+  }
+
+private:
+  static constexpr size_t column_axis = 0;
+  static constexpr size_t row_axis = 1;
+
+  struct axis_tracks {
+    std::vector<track> definitions;
+
+    std::vector<int32_t> content;            // the largest single-track item in each track (dialog units)
+    std::vector<bool> dirty;                 // content has to be recomputed
+    std::vector<std::vector<size_t>> items;  // the single-track items in each track
+    std::vector<size_t> spanning;            // items covering more than one track
+    std::vector<int32_t> measured;           // content, fixed sizes and spanning items (dialog units)
+    std::vector<int32_t> offsets;            // the position of each track and the end of the last (pixels, spacing included)
+  };
+
+  static int32_t& along(size& size, size_t axis) {
+    return axis == column_axis ? size.cx : size.cy;
+  }
+
+  static int32_t along(const size& size, size_t axis) {
+    return axis == column_axis ? size.cx : size.cy;
+  }
+
+  static std::pair<int32_t, int32_t> extent(const cell& cell, size_t axis) {
+    return axis == column_axis ? std::pair{cell.column, cell.column_span} : std::pair{cell.row, cell.row_span};
+  }
+
+  track definition(size_t axis, size_t index) const {
+    const auto& definitions = tracks_[axis].definitions;
+    return index < definitions.size() ? definitions[index] : track::automatic();
+  }
+
+  void set_cell(const cell& cell) {
+    assert(cell.row >= 0 && cell.column >= 0 && cell.row_span > 0 && cell.column_span > 0);
+
+    // items added through the layout API are placed when the grid is next measured
+    cells_.resize(items_.size() - 1, unplaced);
+    cells_.push_back(cell);
+    indexed_count_ = std::min(indexed_count_, cells_.size() - 1);
+  }
+
+  void set_tracks(size_t axis, std::vector<track> definitions) {
+    tracks_[axis].definitions = std::move(definitions);
+    indexed_count_ = 0;
+    invalidate();
+  }
+
+  // places any unplaced items and rebuilds the track indexes when items were added
+  void index_items() const {
+    auto count = items_.size();
+    if (indexed_count_ == count)
+      return;
+
+    cells_.resize(count, unplaced);
+    for (size_t i = 0; i < count; ++i) {
+      if (cells_[i].row >= 0)
+        continue;
+
+      auto next = i == 0 ? cell{} : cells_[i - 1];
+      next.column += next.column_span;
+      next.row_span = next.column_span = 1;
+      if (next.column >= static_cast<int32_t>(std::max<size_t>(tracks_[column_axis].definitions.size(), 1))) {
+        next.column = 0;
+        ++next.row;
+      }
+      cells_[i] = i == 0 ? cell{} : next;
+    }
+
+    for (auto axis : {column_axis, row_axis}) {
+      auto& tracks = tracks_[axis];
+      size_t track_count = tracks.definitions.size();
+      for (const auto& cell : cells_) {
+        auto [first, span] = extent(cell, axis);
+        track_count = std::max(track_count, static_cast<size_t>(first + span));
+      }
+
+      tracks.content.assign(track_count, 0);
+      tracks.dirty.assign(track_count, true);
+      tracks.items.assign(track_count, {});
+      tracks.spanning.clear();
+      tracks.measured.assign(track_count, 0);
+
+      for (size_t i = 0; i < count; ++i) {
+        auto [first, span] = extent(cells_[i], axis);
+        if (span == 1)
+          tracks.items[first].push_back(i);
+        else
+          tracks.spanning.push_back(i);
+      }
+    }
+
+    item_sizes_.assign(count, size{-1, -1});
+    indexed_count_ = count;
+  }
+
+  // sizes the tracks along one axis for `available` pixels and stores their offsets
+  void position_tracks(size_t axis, int32_t available) {
+    auto& tracks = tracks_[axis];
+    auto track_count = tracks.measured.size();
+    auto spacing = axis == column_axis ? to_pixels(spacing_dlu_).cx : to_pixels(spacing_dlu_).cy;
+    auto margin = axis == column_axis ? to_pixels(margin_dlu_).cx : to_pixels(margin_dlu_).cy;
+
+    sizes_.resize(track_count);
+    int64_t remaining = int64_t{available} - margin * 2 - int64_t{spacing} * (static_cast<int64_t>(track_count) - 1);
+    int64_t total_weight = 0;
+    for (size_t t = 0; t < track_count; ++t) {
+      auto def = definition(axis, t);
+      if (def.kind == track::sizing::star) {
+        total_weight += std::max(def.value, 0);
+        continue;
+      }
+
+      sizes_[t] = axis == column_axis ? mul_div(tracks.measured[t], font_size_.cx, 4) : mul_div(tracks.measured[t], font_size_.cy, 8);
+      remaining -= sizes_[t];
+    }
+
+    // the star tracks share what is left by weight, with the rounding spread so that it adds up
+    remaining = std::max<int64_t>(remaining, 0);
+    int64_t cumulative_weight = 0;
+    int64_t given = 0;
+    for (size_t t = 0; t < track_count; ++t) {
+      auto def = definition(axis, t);
+      if (def.kind != track::sizing::star)
+        continue;
+
+      cumulative_weight += std::max(def.value, 0);
+      auto share = total_weight > 0 ? cumulative_weight * remaining / total_weight - given : 0;
+      given += share;
+      sizes_[t] = static_cast<int32_t>(share);
+    }
+
+    tracks.offsets.resize(track_count + 1);
+    int32_t offset = 0;
+    for (size_t t = 0; t < track_count; ++t) {
+      tracks.offsets[t] = offset;
+      offset += sizes_[t] + spacing;
+    }
+    tracks.offsets[track_count] = offset;
+  }
+
+  static constexpr cell unplaced{-1, -1, 1, 1};
+
+  mutable std::array<axis_tracks, 2> tracks_;
+  mutable std::vector<cell> cells_;
+  mutable std::vector<size> item_sizes_; // the preferred size of each item when last measured (dialog units)
+  mutable size_t indexed_count_{};
+
+  mutable bool arranged_valid_{};
+  size arranged_extent_{};
+  size arranged_font_{};
+  std::vector<int32_t> sizes_;
+};
+
+}
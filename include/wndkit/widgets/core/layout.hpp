@@ -0,0 +1,599 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "flat_layout.hpp"
+#include "geometry.hpp"
+
+namespace wndkit::widgets::core {
+
+// identifies an item to the placement sink and the metrics provider (for example an HWND)
+using item_handle = uintptr_t;
+
+// identifies a font to the metrics provider (for example an HFONT)
+using font_handle = uintptr_t;
+
+// receives the rectangles computed by a resize pass
+class placement_sink {
+public:
+  virtual ~placement_sink() = default;
+
+  // `item` has to be moved to `area` (in pixels)
+  virtual void place(item_handle item, const rect& area) = 0;
+};
+
+// supplies the measurements that a layout cannot compute by itself
+class metrics_provider {
+public:
+  virtual ~metrics_provider() = default;
+
+  // the average character width and the character height of `font` (the basis of dialog units)
+  virtual std::optional<size> font_size(font_handle font) = 0;
+
+  // the size (in dialog units) to give `item` when it is added without one
+  virtual std::optional<size> default_size(item_handle item) = 0;
+};
+
+// no maximum size
+inline constexpr int32_t unbounded = std::numeric_limits<int32_t>::max();
+
+// how an item shares space with its siblings (in dialog units)
+struct item_options {
+  int32_t stretch{};                   // share of the free space along a box layout (0 keeps the item's size)
+  size min_dlu{};                      // the item is never made smaller than this...
+  size max_dlu{unbounded, unbounded};  // ...or larger than this
+};
+
+/*
+   The measure and arrange algorithm of a layout, independent of any window system.
+
+   Sizes are in dialog units until a layout is arranged. Items are identified by an opaque
+   `item_handle`, and the computed rectangles are handed to a `placement_sink`, so a layout
+   can be measured and arranged off the UI thread, headless, or for items that are not
+   windows.
+
+   A layout keeps its measured size until something that affects it changes, and remembers
+   the rectangle last placed for each item so that unchanged items are not placed again.
+*/
+class layout {
+public:
+  // how the layout tree is measured and arranged
+  enum class engine {
+    tree, // each layout measures and arranges its own items
+    flat  // box layouts are compiled into flat arrays (see flat_layout) and arranged in one pass
+  };
+
+  using item_options = core::item_options;
+
+  // the outcome of a resize pass
+  struct resize_result {
+    size_t moved{};   // items that were placed
+    size_t skipped{}; // items left alone because their rectangle had not changed
+  };
+
+  explicit layout()
+    : layout({4, 4}) {
+  }
+
+  explicit layout(size spacing_dlu) :
+    spacing_dlu_(spacing_dlu) {
+  }
+
+  virtual ~layout() = default;
+
+  layout(const layout&) = delete;
+  layout& operator=(const layout&) = delete;
+
+  void set_margin(size margin_dlu) {
+    margin_dlu_ = margin_dlu;
+    invalidate();
+  }
+
+  layout& add_widget(item_handle item, alignment_flag align, size size_dlu, const item_options& options = {}) {
+    add_widget_count(1);
+    return add_item(std::make_unique<widget_child_item>(align, options, item, size_dlu));
+  }
+
+  // adds an item sized by the metrics provider
+  layout& add_widget(item_handle item, alignment_flag align, metrics_provider& metrics, const item_options& options = {}) {
+    auto size_dlu = metrics.default_size(item);
+    assert(size_dlu.has_value());
+
+    return add_widget(item, align, size_dlu.value_or(size{}), options);
+  }
+
+  layout& add_layout(std::unique_ptr<layout> layout, alignment_flag align = alignment_flag::none, const item_options& options = {}) {
+    layout->parent_ = this;
+    layout->set_font_size(font_size_);
+    add_widget_count(layout->widget_count_);
+    return add_item(std::make_unique<layout_child_item>(align, options, std::move(layout)));
+  }
+
+  // adds empty space; a spacer with a stretch takes a share of the free space
+  layout& add_spacer(size size_dlu, int32_t stretch = 0) {
+    return add_item(std::make_unique<spacer_child_item>(item_options{stretch}, size_dlu));
+  }
+
+  // adds empty space that only takes a share of the free space
+  layout& add_stretch(int32_t stretch = 1) {
+    return add_spacer({}, stretch);
+  }
+
+  // changes the size hint of an item in this layout (or a nested layout); returns false if the item was not found
+  bool set_widget_size(item_handle item, size size_dlu) {
+    for (auto& child : items_) {
+      if (child->set_widget_size(item, size_dlu)) {
+        invalidate();
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  // removes an item from this layout (or a nested layout); returns false if the item was not found
+  bool remove_widget(item_handle item) {
+    for (size_t i = 0; i < items_.size(); ++i) {
+      if (items_[i]->is_widget(item)) {
+        items_.erase(items_.begin() + static_cast<ptrdiff_t>(i));
+        item_removed(i);
+        for (auto l = this; l; l = l->parent_)
+          --l->widget_count_;
+
+        invalidate();
+        return true;
+      }
+
+      // the nested layout invalidates itself (and so this layout) when it finds the item
+      if (items_[i]->remove_widget(item))
+        return true;
+    }
+
+    return false;
+  }
+
+  void set_font(metrics_provider& metrics, font_handle font) {
+    if (auto size = metrics.font_size(font))
+      set_font_size(size.value());
+  }
+
+  // sets the average character width and height that dialog units are based on
+  void set_font_size(size font_size) {
+    if (font_size == font_size_)
+      return;
+
+    font_size_ = font_size;
+
+    // sizes in dialog units do not depend on the font, so a flat tree only has to be
+    // compiled again if this layout measures something in pixels
+    if (measured_in_pixels())
+      invalidate();
+    else
+      discard_measurement();
+
+    for (auto& item : items_)
+      item->set_font_size(font_size_);
+  }
+
+  size font_size() const {
+    return font_size_;
+  }
+
+  // places the items within `area`, skipping those whose rectangle has not changed since the last resize
+  resize_result resize(const rect& area, placement_sink& sink) {
+    placement placement(sink);
+    if (flat_ && compile_flat())
+      arrange_flat(placement, area);
+    else
+      arrange(placement, area);
+
+    return placement.result();
+  }
+
+  // selects the engine used when this layout is resized; only box layouts can be compiled
+  // into the flat engine, other nested layouts are arranged by themselves
+  void set_engine(engine engine) {
+    if (engine == engine::flat)
+      flat_ = std::make_unique<flat_state>();
+    else
+      flat_.reset();
+
+    // each engine tracks the placed rectangles separately
+    reset_placements();
+  }
+
+  // forgets the rectangles placed by previous resizes, so the next resize places every item
+  // (for example after the items were moved by something other than the layout)
+  void reset_placements() {
+    for (auto& item : items_)
+      item->reset_placements();
+
+    if (flat_)
+      std::fill(flat_->applied.begin(), flat_->applied.end(), std::nullopt);
+  }
+
+  // returns the space that the layout will take up (in dialog units), measuring it only if its content changed
+  size calc_size() const {
+    if (!measured_dlu_.has_value())
+      measured_dlu_ = measure();
+
+    return measured_dlu_.value();
+  }
+
+  // discards the cached measurement of this layout and of every layout containing it, and
+  // the flat trees compiled from them
+  void invalidate() {
+    structure_changed();
+    discard_measurement();
+  }
+
+  // the number of items in this layout and its nested layouts
+  size_t widget_count() const {
+    return widget_count_;
+  }
+
+protected:
+  // counts the items placed and skipped by a resize pass
+  class placement {
+  public:
+    explicit placement(placement_sink& sink) :
+      sink_(sink) {
+    }
+
+    void move(item_handle item, const rect& area) {
+      ++result_.moved;
+      sink_.place(item, area);
+    }
+
+    void skip() {
+      ++result_.skipped;
+    }
+
+    const resize_result& result() const {
+      return result_;
+    }
+
+  private:
+    placement_sink& sink_;
+    resize_result result_;
+  };
+
+  class child_item;
+  class widget_child_item;
+
+  // a layout tree compiled for the flat engine, with the layout or item behind each node
+  struct flat_state {
+    struct node {
+      layout* box;
+      child_item* item;
+      widget_child_item* widget;
+    };
+
+    flat_layout tree;
+    std::vector<node> nodes;
+
+    // items are placed straight from these arrays, without visiting their child_item
+    std::vector<item_handle> handles;
+    std::vector<std::optional<rect>> applied;
+
+    bool compiled{};
+
+    void add_node(node n, item_handle handle = {}, std::optional<rect> applied_rect = {}) {
+      nodes.push_back(n);
+      handles.push_back(handle);
+      applied.push_back(applied_rect);
+    }
+  };
+
+  virtual size measure() const = 0;
+  virtual void arrange(placement& placement, const rect& area) = 0;
+
+  // true if the measured size depends on the font, such as a size in pixels converted to dialog units
+  virtual bool measured_in_pixels() const {
+    return false;
+  }
+
+  // the item at `index` was removed from `items_`; layouts keeping state per item drop it here
+  virtual void item_removed(size_t /*index*/) {}
+
+  // appends this layout to the flat tree as a box; returns false if it cannot be represented as one
+  virtual bool compile_flat(flat_state&, int32_t /*parent*/, alignment_flag) {
+    return false;
+  }
+
+  class child_item {
+  public:
+    child_item(alignment_flag alignment, const item_options& options) :
+      alignment_(alignment),
+      options_(options) {
+    }
+
+    virtual ~child_item() = default;
+
+    auto alignment() const {
+      return alignment_;
+    }
+
+    const auto& options() const {
+      return options_;
+    }
+
+    // the size hint within the item's min/max constraints
+    size preferred_size() {
+      auto hint = calc_size();
+      if (options_.min_dlu == size{} && options_.max_dlu == size{unbounded, unbounded})
+        return hint;
+
+      return {
+        std::clamp(hint.cx, options_.min_dlu.cx, std::max(options_.min_dlu.cx, options_.max_dlu.cx)),
+        std::clamp(hint.cy, options_.min_dlu.cy, std::max(options_.min_dlu.cy, options_.max_dlu.cy))
+      };
+    }
+
+    // whether the item's size can differ from its size hint
+    bool is_flexible() const {
+      return options_.stretch > 0 || options_.min_dlu != size{} || options_.max_dlu != size{unbounded, unbounded};
+    }
+
+    virtual size calc_size() = 0;
+    virtual void arrange(placement& placement, const rect& area) = 0;
+    virtual void set_font_size(size size) = 0;
+    virtual bool set_widget_size(item_handle item, size size_dlu) = 0;
+    virtual void reset_placements() = 0;
+
+    // whether this item is the widget `item`
+    virtual bool is_widget(item_handle) const {
+      return false;
+    }
+
+    // removes `item` from within this item (a nested layout); returns false if it was not found
+    virtual bool remove_widget(item_handle) {
+      return false;
+    }
+
+    virtual void compile_flat(flat_state& flat, int32_t parent) = 0;
+
+  private:
+    alignment_flag alignment_;
+    item_options options_;
+  };
+
+  class widget_child_item : public child_item {
+  public:
+    widget_child_item(alignment_flag alignment, const item_options& options, item_handle item, size size_dlu) :
+      child_item(alignment, options),
+      item_(item),
+      size_dlu_(size_dlu) {
+    }
+
+    auto item() const {
+      return item_;
+    }
+
+    size calc_size() override {
+      return size_dlu_;
+    }
+
+    void arrange(placement& placement, const rect& area) override {
+      if (applied_ == area) {
+        placement.skip();
+        return;
+      }
+
+      placement.move(item_, area);
+      applied_ = area;
+    }
+
+    void set_font_size(size) override {}
+
+    bool set_widget_size(item_handle item, size size_dlu) override {
+      if (item != item_)
+        return false;
+
+      size_dlu_ = size_dlu;
+      return true;
+    }
+
+    void reset_placements() override {
+      applied_.reset();
+    }
+
+    bool is_widget(item_handle item) const override {
+      return item == item_;
+    }
+
+    void compile_flat(flat_state& flat, int32_t parent) override {
+      flat.tree.add_item(parent, alignment(), size_dlu_);
+      flat.add_node({nullptr, this, this}, item_, applied_);
+    }
+
+    void set_applied(const std::optional<rect>& applied) {
+      applied_ = applied;
+    }
+
+  private:
+    item_handle item_;
+    size size_dlu_;
+    std::optional<rect> applied_;
+  };
+
+  class layout_child_item : public child_item {
+  public:
+    layout_child_item(alignment_flag alignment, const item_options& options, std::unique_ptr<layout> layout) :
+      child_item(alignment, options),
+      layout_(std::move(layout)) {
+    }
+
+    size calc_size() override {
+      return layout_->calc_size();
+    }
+
+    void arrange(placement& placement, const rect& area) override {
+      layout_->arrange(placement, area);
+    }
+
+    void set_font_size(size size) override {
+      layout_->set_font_size(size);
+    }
+
+    bool set_widget_size(item_handle item, size size_dlu) override {
+      // the nested layout invalidates itself (and so this layout) when it finds the item
+      return layout_->set_widget_size(item, size_dlu);
+    }
+
+    void reset_placements() override {
+      layout_->reset_placements();
+    }
+
+    bool remove_widget(item_handle item) override {
+      return layout_->remove_widget(item);
+    }
+
+    void compile_flat(flat_state& flat, int32_t parent) override {
+      // anything other than a box is placed as a single item that arranges itself
+      if (!layout_->compile_flat(flat, parent, alignment())) {
+        flat.tree.add_item(parent, alignment(), layout_->calc_size());
+        flat.add_node({nullptr, this, nullptr});
+      }
+    }
+
+  private:
+    std::unique_ptr<layout> layout_;
+  };
+
+  class spacer_child_item : public child_item {
+  public:
+    spacer_child_item(const item_options& options, size size_dlu) :
+      child_item(alignment_flag::none, options),
+      size_dlu_(size_dlu) {
+    }
+
+    size calc_size() override {
+      return size_dlu_;
+    }
+
+    void arrange(placement&, const rect&) override {}
+    void set_font_size(size) override {}
+
+    bool set_widget_size(item_handle, size) override {
+      return false;
+    }
+
+    void reset_placements() override {}
+
+    void compile_flat(flat_state& flat, int32_t parent) override {
+      flat.tree.add_item(parent, alignment(), size_dlu_);
+      flat.add_node({nullptr, this, nullptr});
+    }
+
+  private:
+    size size_dlu_;
+  };
+
+  // Compute base unit size (DLU)
+  size to_pixels(size dlu) const {
+    return {
+      mul_div(dlu.cx, font_size_.cx, 4),
+      mul_div(dlu.cy, font_size_.cy, 8)
+    };
+  }
+
+  size font_size_{};
+  std::vector<std::unique_ptr<child_item>> items_;
+  size margin_dlu_{};
+  size spacing_dlu_{};
+
+private:
+  layout& add_item(std::unique_ptr<child_item> item) {
+    items_.push_back(std::move(item));
+    invalidate();
+
+    return *this;
+  }
+
+  void arrange_flat(placement& placement, const rect& area) {
+    auto& flat = *flat_;
+    flat.tree.arrange(area, font_size_);
+
+    for (int32_t i = 0; i < flat.tree.node_count(); ++i) {
+      const auto& item_area = flat.tree.arranged_rect(i);
+      if (flat.nodes[i].widget) {
+        if (flat.applied[i] == item_area) {
+          placement.skip();
+        } else {
+          placement.move(flat.handles[i], item_area);
+          flat.applied[i] = item_area;
+        }
+      } else if (auto item = flat.nodes[i].item) {
+        item->arrange(placement, item_area);
+      }
+    }
+  }
+
+  // compiles and measures the flat tree if the layout changed since it was last compiled
+  bool compile_flat() {
+    auto& flat = *flat_;
+    if (flat.compiled)
+      return true;
+
+    // hand the placed rectangles back to the items so they survive the recompile
+    for (size_t i = 0; i < flat.nodes.size(); ++i) {
+      if (auto widget = flat.nodes[i].widget)
+        widget->set_applied(flat.applied[i]);
+    }
+
+    flat.tree.clear();
+    flat.nodes.clear();
+    flat.handles.clear();
+    flat.applied.clear();
+    flat.tree.reserve(widget_count_ + 1);
+    if (!compile_flat(flat, -1, alignment_flag::none))
+      return false;
+
+    flat.tree.measure();
+
+    // the flat tree measured every box, so their cached sizes are brought up to date
+    for (int32_t i = 0; i < flat.tree.node_count(); ++i) {
+      if (auto box = flat.nodes[i].box)
+        box->measured_dlu_ = flat.tree.measured_size(i);
+    }
+
+    flat.compiled = true;
+    return true;
+  }
+
+  void discard_measurement() {
+    // a dirty layout's ancestors are already dirty
+    if (!measured_dlu_.has_value())
+      return;
+
+    measured_dlu_.reset();
+    if (parent_)
+      parent_->discard_measurement();
+  }
+
+  // the flat trees containing this layout must be compiled again
+  void structure_changed() {
+    for (auto l = this; l; l = l->parent_) {
+      if (l->flat_)
+        l->flat_->compiled = false;
+    }
+  }
+
+  void add_widget_count(size_t count) {
+    for (auto l = this; l; l = l->parent_)
+      l->widget_count_ += count;
+  }
+
+  layout* parent_{};
+  mutable std::optional<size> measured_dlu_;
+  size_t widget_count_{}; // items in this layout and its nested layouts
+  std::unique_ptr<flat_state> flat_;
+};
+
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace wndkit::widgets::core {
+
+/*
+   Hands frames rendered on a worker thread to the thread that shows them.
+
+   The UI thread `request`s a frame (a `Request` describes what to render, such as its size);
+   the worker `wait`s for a request, renders it into the buffer the job names and
+   `complete`s it; the UI thread then `present`s the latest completed frame.
+
+   There are three buffers: the one being shown, the last completed one not yet shown and
+   the one being rendered, so neither thread waits for the other to finish with a buffer.
+   Requests made while the worker is busy are coalesced (only the latest is rendered), a
+   completed frame replaces a completed frame that was never shown, and a frame older than
+   the one already completed is dropped. A long render can check `superseded` to give up
+   early (and `abandon` its job).
+
+   The queue is meant for one worker thread. Buffers are identified by index; the caller
+   owns the storage. This header has no Win32 dependencies.
+*/
+template<typename Request>
+class render_queue {
+public:
+  static constexpr size_t buffer_count = 3;
+
+  // a frame to render: `buffer` is the index of the buffer to render into
+  struct job {
+    uint64_t generation{};
+    Request request{};
+    size_t buffer{};
+  };
+
+  // a completed frame
+  struct frame {
+    uint64_t generation{};
+    Request request{};
+    size_t buffer{};
+  };
+
+  struct statistics {
+    uint64_t requests{};
+    uint64_t coalesced{};  // requests replaced by a later one before they were rendered
+    uint64_t completed{};  // frames made ready to show
+    uint64_t dropped{};    // frames completed but never shown (replaced, older, or abandoned)
+  };
+
+  render_queue() = default;
+
+  render_queue(const render_queue&) = delete;
+  render_queue& operator=(const render_queue&) = delete;
+
+  // asks for a frame; returns its generation (generations increase with each request)
+  uint64_t request(Request request) {
+    std::lock_guard lock(mutex_);
+    if (pending_)
+      ++statistics_.coalesced;
+
+    pending_ = job{++generation_, std::move(request)};
+    ++statistics_.requests;
+    changed_.notify_all();
+    return generation_;
+  }
+
+  // waits for a request to render; returns nothing once `stop` has been called
+  std::optional<job> wait() {
+    std::unique_lock lock(mutex_);
+    changed_.wait(lock, [this] { return stopped_ || pending_; });
+    if (stopped_)
+      return {};
+
+    auto next = std::move(*pending_);
+    pending_.reset();
+    next.buffer = free_buffer();
+    rendering_[next.buffer] = true;
+    return next;
+  }
+
+  // true if a render of `generation` is no longer needed (a newer request is waiting, or the queue is stopped)
+  bool superseded(uint64_t generation) const {
+    std::lock_guard lock(mutex_);
+    return stopped_ || (pending_ && pending_->generation > generation);
+  }
+
+  // makes a rendered frame ready to show; returns false if it was dropped (the caller need not repaint)
+  bool complete(const job& job) {
+    std::lock_guard lock(mutex_);
+    rendering_[job.buffer] = false;
+
+    if (stopped_ || (ready_ && ready_->generation > job.generation) || (front_ && front_->generation > job.generation)) {
+      ++statistics_.dropped;
+      return false;
+    }
+
+    if (ready_)
+      ++statistics_.dropped;
+
+    ready_ = frame{job.generation, job.request, job.buffer};
+    ++statistics_.completed;
+    return true;
+  }
+
+  // gives back the buffer of a job that was not rendered
+  void abandon(const job& job) {
+    std::lock_guard lock(mutex_);
+    rendering_[job.buffer] = false;
+    ++statistics_.dropped;
+  }
+
+  // the frame to show: the latest completed frame, or the one shown last if none completed since;
+  // its buffer is not rendered into until a newer frame is presented
+  std::optional<frame> present() {
+    std::lock_guard lock(mutex_);
+    if (ready_) {
+      front_ = std::move(ready_);
+      ready_.reset();
+    }
+
+    return front_;
+  }
+
+  // wakes the worker (its `wait` returns nothing) and drops any waiting request
+  void stop() {
+    std::lock_guard lock(mutex_);
+    stopped_ = true;
+    pending_.reset();
+    changed_.notify_all();
+  }
+
+  bool stopped() const {
+    std::lock_guard lock(mutex_);
+    return stopped_;
+  }
+
+  statistics stats() const {
+    std::lock_guard lock(mutex_);
+    return statistics_;
+  }
+
+private:
+  // a buffer neither shown, ready to show nor being rendered
+  size_t free_buffer() {
+    for (size_t buffer = 0; buffer < buffer_count; ++buffer) {
+      if (!rendering_[buffer] && (!front_ || front_->buffer != buffer) && (!ready_ || ready_->buffer != buffer))
+        return buffer;
+    }
+
+    // only with more than one worker: the ready frame gives up its buffer
+    assert(ready_);
+    auto buffer = ready_->buffer;
+    ready_.reset();
+    ++statistics_.dropped;
+    return buffer;
+  }
+
+  mutable std::mutex mutex_;
+  std::condition_variable changed_;
+  uint64_t generation_{};
+  std::optional<job> pending_;                 // the latest request not yet rendered
+  std::optional<frame> ready_;                 // the latest completed frame not yet shown
+  std::optional<frame> front_;                 // the frame being shown
+  std::array<bool, buffer_count> rendering_{}; // the buffers workers are rendering into
+  bool stopped_{};
+  statistics statistics_;
+};
+
+}
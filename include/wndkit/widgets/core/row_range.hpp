@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace wndkit::widgets::core {
+
+// a half-open range of rows, [first, last)
+struct row_range {
+  size_t first{};
+  size_t last{};
+
+  constexpr size_t size() const {
+    return last - first;
+  }
+
+  constexpr bool contains(size_t row) const {
+    return row >= first && row < last;
+  }
+
+  constexpr bool operator==(const row_range&) const = default;
+};
+
+// the rows of `count` rows, `row_height` high, that a viewport `viewport` high scrolled to `offset` shows,
+// widened by `overscan` rows on each side
+constexpr row_range visible_rows(int64_t offset, int64_t viewport, int32_t row_height, size_t count, size_t overscan) {
+  if (row_height <= 0 || count == 0 || viewport <= 0)
+    return {};
+
+  auto first = static_cast<size_t>(std::max<int64_t>(offset, 0) / row_height);
+  auto last = static_cast<size_t>((std::max<int64_t>(offset, 0) + viewport + row_height - 1) / row_height);
+
+  first = first > overscan ? first - overscan : 0;
+  last = std::min(last + overscan, count);
+  return {std::min(first, last), last};
+}
+
+// the largest scroll offset of `count` rows, `row_height` high, in a viewport `viewport` high
+constexpr int64_t max_scroll_offset(int64_t viewport, int32_t row_height, size_t count) {
+  return std::max<int64_t>(static_cast<int64_t>(count) * row_height - viewport, 0);
+}
+
+}
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "geometry.hpp"
+
+namespace wndkit::widgets::core {
+
+/*
+   Finds the topmost rectangle at a point.
+
+   Rectangles are bucketed in a uniform grid of square cells. A point query looks at the
+   one cell holding the point, whose entries are kept ordered from the top down, so it
+   stops at the first rectangle containing the point; the cost depends on how many
+   rectangles overlap that cell, not on how many there are.
+
+   A rectangle that would cover more than 16 cells goes in a coarser grid instead, whose
+   cells are four times as wide, or a coarser one still, so every rectangle is in a few
+   cells of one level. A query looks at one cell of each level in use.
+
+   Each rectangle has a key (such as an item handle) and a z-order; when rectangles
+   overlap, the one with the higher z is on top.
+
+   This header has no Win32 dependencies.
+*/
+class spatial_index {
+public:
+  using key_type = uintptr_t;
+
+  explicit spatial_index(int32_t cell_size = 64) :
+    cell_size_(std::max(cell_size, 1)) {
+  }
+
+  // adds a rectangle, or moves it if the key is already indexed
+  void set(key_type key, const rect& area, int32_t z = 0) {
+    auto [it, added] = entries_.try_emplace(key);
+    auto& entry = it->second;
+    if (!added) {
+      if (entry.area == area && entry.z == z)
+        return;
+      unlink(key, entry);
+    }
+
+    entry.area = area;
+    entry.z = z;
+    link(key, entry);
+  }
+
+  void remove(key_type key) {
+    auto it = entries_.find(key);
+    if (it == entries_.end())
+      return;
+
+    unlink(key, it->second);
+    entries_.erase(it);
+  }
+
+  void clear() {
+    entries_.clear();
+    levels_.clear();
+  }
+
+  size_t size() const {
+    return entries_.size();
+  }
+
+  // the key of the topmost rectangle containing the point, if any
+  std::optional<key_type> query(int32_t x, int32_t y) const {
+    const slot* top = nullptr;
+
+    for (const auto& level : levels_) {
+      if (level.count == 0)
+        continue;
+
+      auto it = level.cells.find(cell_key(level.cell_of(x), level.cell_of(y)));
+      if (it == level.cells.end())
+        continue;
+
+      // a slot below the topmost found so far can not replace it
+      for (const auto& slot : it->second) {
+        if (top && !above(slot, *top))
+          break;
+        if (contains(slot.area, x, y)) {
+          top = &slot;
+          break;
+        }
+      }
+    }
+
+    if (!top)
+      return {};
+
+    return top->key;
+  }
+
+private:
+  // rectangles covering more cells than this go in a coarser level
+  static constexpr int64_t max_cells_per_entry = 16;
+
+  // each level's cells are this many times as wide as the level below
+  static constexpr int32_t level_scale = 4;
+
+  // the cells of the coarsest level are at least 2^30 wide, so any rectangle fits in 16 of them
+  static constexpr size_t max_levels = 16;
+
+  struct entry {
+    rect area;
+    int32_t z{};
+    uint32_t level{};
+  };
+
+  // a copy of the entry in a cell, so a query does not have to look the entry up
+  struct slot {
+    rect area;
+    int32_t z;
+    key_type key;
+  };
+
+  // topmost first; among equal z, the later key wins so the order is stable
+  static bool above(const slot& a, const slot& b) {
+    return a.z != b.z ? a.z > b.z : a.key > b.key;
+  }
+
+  static bool contains(const rect& area, int32_t x, int32_t y) {
+    return x >= area.left && x < area.right && y >= area.top && y < area.bottom;
+  }
+
+  struct level {
+    explicit level(int64_t cell_size) :
+      cell_size(cell_size) {
+    }
+
+    int64_t cell_size;
+    std::unordered_map<uint64_t, std::vector<slot>> cells; // topmost first
+    size_t count{};                                        // the rectangles in this level
+
+    int32_t cell_of(int32_t coordinate) const {
+      // rounds towards negative infinity so negative coordinates get their own cells
+      return static_cast<int32_t>(coordinate >= 0 ? coordinate / cell_size : -((-int64_t{coordinate} + cell_size - 1) / cell_size));
+    }
+
+    // whether `area` covers few enough cells of this level (each side is checked first, so the product can not overflow)
+    bool fits(const rect& area) const {
+      auto columns = int64_t{cell_of(area.right - 1)} - cell_of(area.left) + 1;
+      auto rows = int64_t{cell_of(area.bottom - 1)} - cell_of(area.top) + 1;
+      return columns <= max_cells_per_entry && rows <= max_cells_per_entry && columns * rows <= max_cells_per_entry;
+    }
+
+    template<typename Fn>
+    void for_each_cell(const rect& area, Fn&& fn) const {
+      auto left = cell_of(area.left);
+      auto top = cell_of(area.top);
+      auto right = cell_of(area.right - 1);
+      auto bottom = cell_of(area.bottom - 1);
+
+      for (auto row = top; row <= bottom; ++row) {
+        for (auto column = left; column <= right; ++column)
+          fn(cell_key(column, row));
+      }
+    }
+  };
+
+  static uint64_t cell_key(int32_t column, int32_t row) {
+    return (uint64_t{static_cast<uint32_t>(column)} << 32) | static_cast<uint32_t>(row);
+  }
+
+  static bool empty(const rect& area) {
+    return area.right <= area.left || area.bottom <= area.top;
+  }
+
+  // the finest level in which `area` covers few enough cells, adding levels as needed
+  uint32_t level_for(const rect& area) {
+    uint32_t index = 0;
+    for (;; ++index) {
+      if (index == levels_.size())
+        levels_.emplace_back(index == 0 ? int64_t{cell_size_} : levels_.back().cell_size * level_scale);
+      if (index + 1 == max_levels || levels_[index].fits(area))
+        return index;
+    }
+  }
+
+  static void insert_sorted(std::vector<slot>& slots, const slot& added) {
+    auto at = std::upper_bound(slots.begin(), slots.end(), added, [](const slot& a, const slot& b) { return above(a, b); });
+    slots.insert(at, added);
+  }
+
+  static void erase_key(std::vector<slot>& slots, key_type key) {
+    std::erase_if(slots, [key](const slot& slot) { return slot.key == key; });
+  }
+
+  void link(key_type key, entry& entry) {
+    // empty rectangles are never hit
+    if (empty(entry.area))
+      return;
+
+    entry.level = level_for(entry.area);
+    auto& level = levels_[entry.level];
+    slot added{entry.area, entry.z, key};
+    level.for_each_cell(entry.area, [&](uint64_t cell) { insert_sorted(level.cells[cell], added); });
+    ++level.count;
+  }
+
+  void unlink(key_type key, const entry& entry) {
+    if (empty(entry.area))
+      return;
+
+    auto& level = levels_[entry.level];
+    level.for_each_cell(entry.area, [&](uint64_t cell) {
+      auto it = level.cells.find(cell);
+      erase_key(it->second, key);
+      if (it->second.empty())
+        level.cells.erase(it);
+    });
+    --level.count;
+  }
+
+  int32_t cell_size_;
+  std::unordered_map<key_type, entry> entries_;
+  std::vector<level> levels_; // the finest first
+};
+
+}
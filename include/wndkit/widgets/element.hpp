@@ -0,0 +1,457 @@
+#pragma once
+
+#include <windows.h>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <wil/resource.h>
+#include <wndkit/message_handler.hpp>
+#include "buffered_paint.hpp"
+#include "core/layout.hpp"
+#include "core/spatial_index.hpp"
+#include "text_measure_cache.hpp"
+#include "tooltip_manager.hpp"
+
+namespace wndkit::widgets {
+
+class element_host;
+class element_layout;
+
+/*
+   A windowless part of a window, such as a label or a link.
+
+   An element has no HWND of its own: the window it belongs to (through an `element_host`)
+   paints it in its WM_PAINT, hit-tests it in its mouse handlers and forwards it the
+   resulting events. A layout places elements like widgets (see `layout::add_element`).
+*/
+class element {
+public:
+  element() = default;
+
+  element(const element&) = delete;
+  element& operator=(const element&) = delete;
+
+  virtual ~element();
+
+  const RECT& bounds() const {
+    return bounds_;
+  }
+
+  // moves the element, repainting the area it left and the area it now covers
+  void set_bounds(const RECT& bounds);
+
+  bool visible() const {
+    return visible_;
+  }
+
+  void set_visible(bool visible);
+
+  // repaints the element
+  void invalidate();
+
+  element_host* host() const {
+    return host_;
+  }
+
+  // the size used when the element is added to a layout without a size and has no `content_size` (in dialog units)
+  virtual SIZE default_size_dlu() const {
+    return {50, 8};
+  }
+
+  // the size the element needs to show its content (in pixels), used when it is added to a layout without a size
+  virtual std::optional<SIZE> content_size() const {
+    return {};
+  }
+
+  bool hit_test(POINT point) const {
+    return visible_ && PtInRect(&bounds_, point);
+  }
+
+protected:
+  friend class element_host;
+  friend class element_layout;
+
+  // measures text drawn with the host's font (through the process-wide `text_measure_cache`); null without a host window
+  std::shared_ptr<const text_extent> measure_text(std::wstring_view text, UINT format, int32_t max_width = 0) const;
+
+  // tells the layout the element is in that `content_size` changed; it is measured again on the next layout pass
+  void invalidate_size();
+
+  // paints the element within `bounds()`; the DC is clipped to the bounds and has the host's font selected
+  virtual void paint(HDC hdc) = 0;
+
+  // the text of the element's tooltip (asked for each time it shows), or empty for none
+  virtual std::wstring tooltip_text() const {
+    return {};
+  }
+
+  // the cursor shown over the element, or null for the host window's cursor
+  virtual HCURSOR cursor() const {
+    return nullptr;
+  }
+
+  virtual void on_mouse_enter() {}
+  virtual void on_mouse_leave() {}
+  virtual void on_button_down() {}
+
+  // the left button was pressed and released over the element
+  virtual void on_click() {}
+
+private:
+  element_host* host_{};
+  element_layout* layout_{}; // the layout item placing the element, if any
+  RECT bounds_{};
+  bool visible_{true};
+  int32_t z_{}; // the painting order within the host
+};
+
+/*
+   Paints, hit-tests and dispatches mouse input to the elements of a window.
+
+   The host adds handlers for WM_PAINT, WM_MOUSEMOVE, WM_MOUSELEAVE, WM_LBUTTONDOWN,
+   WM_LBUTTONUP, WM_CAPTURECHANGED and WM_SETCURSOR to the window's message handler.
+   Elements added later are painted above (and hit-tested before) elements added earlier.
+   The mouse is captured while the button is held over an element, so the release is seen
+   even outside the window.
+
+   Painting goes through a `buffered_paint`, so the window's background (its class brush)
+   and the elements over it reach the screen together, and only the invalid region is
+   drawn.
+
+   Hit-testing runs at input rate, so the host keeps the visible elements' bounds in a
+   `core::spatial_index`, updated whenever an element moves (including when a layout
+   arranges it). The same bounds are registered as rectangle tools with the top-level
+   window's `tooltip_manager`, so elements share its tooltip window.
+*/
+class element_host {
+public:
+  explicit element_host(wndkit::message_handler& handler) {
+    handler
+      .on_message<WM_PAINT>([this](HWND hwnd, const auto&) { return on_paint(hwnd); })
+      .on_message<WM_MOUSEMOVE>([this](HWND hwnd, const auto& params) { return on_mouse_move(hwnd, params.pos()); })
+      .on_message<WM_MOUSELEAVE>([this](HWND, const auto&) { return on_mouse_leave(); })
+      .on_message<WM_LBUTTONDOWN>([this](HWND hwnd, const auto& params) { return on_button_down(hwnd, params.pos()); })
+      .on_message<WM_LBUTTONUP>([this](HWND hwnd, const auto& params) { return on_button_up(hwnd, params.pos()); })
+      .on_message<WM_CAPTURECHANGED>([this](HWND, const auto&) { return on_capture_changed(); })
+      .on_message<WM_SETCURSOR>([this](HWND hwnd, const auto& params) { return on_set_cursor(hwnd, params); })
+    ;
+  }
+
+  element_host(const element_host&) = delete;
+  element_host& operator=(const element_host&) = delete;
+
+  ~element_host() {
+    for (auto element : elements_)
+      element->host_ = nullptr;
+  }
+
+  // the window the elements are drawn in
+  void attach(HWND hwnd) {
+    hwnd_ = hwnd;
+    for (auto element : elements_)
+      index(*element);
+  }
+
+  HWND hwnd() const {
+    return hwnd_;
+  }
+
+  void add(element& element) {
+    assert(!element.host_);
+
+    element.host_ = this;
+    element.z_ = next_z_++;
+    elements_.push_back(&element);
+    index(element);
+    element.invalidate();
+  }
+
+  void remove(element& element) {
+    if (element.host_ != this)
+      return;
+
+    element.invalidate();
+    element.host_ = nullptr;
+    std::erase(elements_, &element);
+    index_.remove(to_key(element));
+    remove_tool(element);
+
+    if (hovered_ == &element)
+      hovered_ = nullptr;
+    if (pressed_ == &element) {
+      pressed_ = nullptr;
+      release_capture();
+    }
+  }
+
+  void set_font(HFONT font) {
+    font_ = font;
+    if (hwnd_)
+      InvalidateRect(hwnd_, nullptr, FALSE);
+  }
+
+  HFONT font() const {
+    return font_;
+  }
+
+  // the font the elements are drawn with
+  HFONT drawing_font() const {
+    return font_ ? font_ : static_cast<HFONT>(GetStockObject(DEFAULT_GUI_FONT));
+  }
+
+  // the topmost element at `point` (in client coordinates), or null
+  element* element_at(POINT point) const {
+    auto key = index_.query(point.x, point.y);
+    return key ? reinterpret_cast<element*>(*key) : nullptr;
+  }
+
+  // updates the hit-testing index after an element moved, or was shown or hidden
+  void index(const element& element) {
+    if (element.visible_) {
+      index_.set(to_key(element), {element.bounds_.left, element.bounds_.top, element.bounds_.right, element.bounds_.bottom}, element.z_);
+      if (hwnd_)
+        tooltip_manager::for_window(hwnd_).add_tool(hwnd_, to_key(element), element.bounds_, [&element] { return element.tooltip_text(); });
+    } else {
+      index_.remove(to_key(element));
+      remove_tool(element);
+    }
+  }
+
+  // repaints an area; the background is painted with the elements, so it is not erased
+  void invalidate(const RECT& area) {
+    if (hwnd_ && !IsRectEmpty(&area))
+      InvalidateRect(hwnd_, &area, FALSE);
+  }
+
+private:
+  static core::spatial_index::key_type to_key(const element& element) {
+    return reinterpret_cast<core::spatial_index::key_type>(&element);
+  }
+
+  void remove_tool(const element& element) {
+    if (auto tooltips = hwnd_ ? tooltip_manager::find(hwnd_) : nullptr)
+      tooltips->remove_tool(hwnd_, to_key(element));
+  }
+
+  void release_capture() const {
+    if (hwnd_ && GetCapture() == hwnd_)
+      ReleaseCapture();
+  }
+
+  std::optional<LRESULT> on_paint(HWND hwnd) {
+    if (elements_.empty())
+      return std::nullopt;
+
+    buffered_paint paint(hwnd);
+    auto hdc = paint.hdc();
+
+    auto background = reinterpret_cast<HBRUSH>(GetClassLongPtrW(hwnd, GCLP_HBRBACKGROUND));
+    paint.fill(background ? background : reinterpret_cast<HBRUSH>(COLOR_WINDOW + 1));
+
+    auto old_font = wil::SelectObject(hdc, drawing_font());
+    SetBkMode(hdc, TRANSPARENT);
+
+    RECT overlap{};
+    for (auto element : elements_) {
+      if (!element->visible_ || !IntersectRect(&overlap, &element->bounds_, &paint.dirty()))
+        continue;
+
+      auto saved = SaveDC(hdc);
+      IntersectClipRect(hdc, element->bounds_.left, element->bounds_.top, element->bounds_.right, element->bounds_.bottom);
+      element->paint(hdc);
+      RestoreDC(hdc, saved);
+    }
+
+    return 0;
+  }
+
+  std::optional<LRESULT> on_mouse_move(HWND hwnd, POINT point) {
+    auto hit = element_at(point);
+    if (hit != hovered_) {
+      if (hovered_)
+        hovered_->on_mouse_leave();
+
+      hovered_ = hit;
+      if (hovered_) {
+        TRACKMOUSEEVENT tme{sizeof(TRACKMOUSEEVENT), TME_LEAVE, hwnd, 0};
+        TrackMouseEvent(&tme);
+        hovered_->on_mouse_enter();
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  std::optional<LRESULT> on_mouse_leave() {
+    if (hovered_) {
+      hovered_->on_mouse_leave();
+      hovered_ = nullptr;
+    }
+
+    return std::nullopt;
+  }
+
+  std::optional<LRESULT> on_button_down(HWND hwnd, POINT point) {
+    pressed_ = element_at(point);
+    if (!pressed_)
+      return std::nullopt;
+
+    // the button may be released outside the window
+    SetCapture(hwnd);
+    pressed_->on_button_down();
+    return 0;
+  }
+
+  std::optional<LRESULT> on_button_up(HWND hwnd, POINT point) {
+    auto pressed = std::exchange(pressed_, nullptr);
+    if (!pressed)
+      return std::nullopt;
+
+    if (GetCapture() == hwnd)
+      ReleaseCapture();
+
+    if (element_at(point) == pressed)
+      pressed->on_click();
+    return 0;
+  }
+
+  // the capture was released, or taken by another window (such as a menu or a drag): the press is cancelled
+  std::optional<LRESULT> on_capture_changed() {
+    pressed_ = nullptr;
+    return std::nullopt;
+  }
+
+  std::optional<LRESULT> on_set_cursor(HWND hwnd, const setcursor_params& params) {
+    if (params.cursor_owner() != hwnd || params.hit_test_code() != HTCLIENT || !hovered_)
+      return std::nullopt;
+
+    auto cursor = hovered_->cursor();
+    if (!cursor)
+      return std::nullopt;
+
+    SetCursor(cursor);
+    return TRUE;
+  }
+
+  HWND hwnd_{};
+  HFONT font_{};
+  std::vector<element*> elements_; // in painting order
+  core::spatial_index index_;      // the bounds of the visible elements
+  int32_t next_z_{};
+  element* hovered_{};
+  element* pressed_{};
+};
+
+inline void element::set_bounds(const RECT& bounds) {
+  if (EqualRect(&bounds_, &bounds))
+    return;
+
+  invalidate();
+  bounds_ = bounds;
+  if (host_)
+    host_->index(*this);
+  invalidate();
+}
+
+inline void element::set_visible(bool visible) {
+  if (visible_ == visible)
+    return;
+
+  visible_ = visible;
+  if (host_) {
+    host_->index(*this);
+    host_->invalidate(bounds_);
+  }
+}
+
+inline void element::invalidate() {
+  if (host_ && visible_)
+    host_->invalidate(bounds_);
+}
+
+inline std::shared_ptr<const text_extent> element::measure_text(std::wstring_view text, UINT format, int32_t max_width) const {
+  if (!host_ || !host_->hwnd())
+    return nullptr;
+
+  auto hwnd = host_->hwnd();
+  return text_measure_cache::instance().measure(hwnd, host_->drawing_font(), GetDpiForWindow(hwnd), text, format, max_width);
+}
+
+/*
+   Places an element as a layout item.
+
+   The element is a leaf; it is arranged like a widget, but by setting its bounds rather
+   than by moving a window. Without a fixed size, it is measured with its `content_size`
+   (converted to dialog units with the layout's font), or `default_size_dlu` if it has none.
+*/
+class element_layout : public core::layout {
+public:
+  element_layout(element& element, std::optional<core::size> size_dlu) :
+    element_(&element),
+    size_dlu_(size_dlu) {
+    element_->layout_ = this;
+  }
+
+  ~element_layout() override {
+    if (element_ && element_->layout_ == this)
+      element_->layout_ = nullptr;
+  }
+
+  // called when the element is destroyed before the layout; the item keeps its size but no longer places anything
+  void detach() {
+    element_ = nullptr;
+  }
+
+protected:
+  core::size measure() const override {
+    if (size_dlu_)
+      return *size_dlu_;
+    if (!element_)
+      return {};
+
+    auto font_size = this->font_size();
+    if (auto content = element_->content_size(); content && font_size.cx > 0 && font_size.cy > 0) {
+      // rounded up, so the content is not clipped
+      return {
+        (content->cx * 4 + font_size.cx - 1) / font_size.cx,
+        (content->cy * 8 + font_size.cy - 1) / font_size.cy
+      };
+    }
+
+    auto size = element_->default_size_dlu();
+    return {size.cx, size.cy};
+  }
+
+  void arrange(placement&, const core::rect& area) override {
+    if (element_)
+      element_->set_bounds({area.left, area.top, area.right, area.bottom});
+  }
+
+  // a content size is converted with the font, so a font change has to measure the element again
+  bool measured_in_pixels() const override {
+    return !size_dlu_;
+  }
+
+private:
+  element* element_; // null once the element is destroyed
+  std::optional<core::size> size_dlu_;
+};
+
+inline element::~element() {
+  if (layout_)
+    layout_->detach();
+  if (host_)
+    host_->remove(*this);
+}
+
+inline void element::invalidate_size() {
+  if (layout_)
+    layout_->invalidate();
+}
+
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <windows.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cwchar>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <wil/resource.h>
+#include "core/geometry.hpp"
+
+namespace wndkit::widgets {
+
+/*
+   The average character size of fonts, shared by every layout in the process.
+
+   Measuring a font needs a device context and a GetTextMetricsW call; the result is cached
+   per font and DPI. A font handle can be reused after the font is deleted, so an entry
+   also records the font's LOGFONTW and is measured again if the handle now names a
+   different font.
+
+   top_level_window clears the cache on WM_DPICHANGED and when a WM_SETTINGCHANGE changes
+   the system fonts or their smoothing.
+*/
+class font_metrics_cache {
+public:
+  struct statistics {
+    uint64_t hits{};
+    uint64_t misses{};
+
+    double hit_rate() const {
+      auto lookups = hits + misses;
+      return lookups ? static_cast<double>(hits) / lookups : 0.0;
+    }
+  };
+
+  static font_metrics_cache& instance() {
+    static font_metrics_cache cache;
+    return cache;
+  }
+
+  font_metrics_cache(const font_metrics_cache&) = delete;
+  font_metrics_cache& operator=(const font_metrics_cache&) = delete;
+
+  // the average character width and height of `font` at `dpi`, measured with the device context of `hwnd` if not cached
+  std::optional<core::size> font_size(HWND hwnd, HFONT font, UINT dpi) {
+    LOGFONTW log_font{};
+    if (font && !GetObjectW(font, sizeof(log_font), &log_font))
+      return {};
+
+    std::pair key{font, dpi};
+    {
+      std::lock_guard lock(mutex_);
+      if (auto it = entries_.find(key); it != entries_.end() && same_font(it->second.log_font, log_font)) {
+        ++statistics_.hits;
+        return it->second.size;
+      }
+      ++statistics_.misses;
+    }
+
+    auto hdc = wil::GetDC(hwnd);
+    auto old_font = wil::SelectObject(hdc.get(), font);
+
+    TEXTMETRICW tm;
+    if (!GetTextMetricsW(hdc.get(), &tm))
+      return {};
+
+    core::size size{tm.tmAveCharWidth, tm.tmHeight};
+
+    std::lock_guard lock(mutex_);
+    entries_[key] = {log_font, size};
+    return size;
+  }
+
+  // forgets every measurement (for example when the system fonts or the DPI changed)
+  void clear() {
+    std::lock_guard lock(mutex_);
+    entries_.clear();
+  }
+
+  statistics stats() const {
+    std::lock_guard lock(mutex_);
+    return statistics_;
+  }
+
+  void reset_statistics() {
+    std::lock_guard lock(mutex_);
+    statistics_ = {};
+  }
+
+private:
+  font_metrics_cache() = default;
+
+  struct entry {
+    LOGFONTW log_font;
+    core::size size;
+  };
+
+  static bool same_font(const LOGFONTW& a, const LOGFONTW& b) {
+    return std::memcmp(&a, &b, offsetof(LOGFONTW, lfFaceName)) == 0 && std::wcscmp(a.lfFaceName, b.lfFaceName) == 0;
+  }
+
+  mutable std::mutex mutex_;
+  std::map<std::pair<HFONT, UINT>, entry> entries_;
+  statistics statistics_;
+};
+
+}
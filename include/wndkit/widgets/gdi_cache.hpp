@@ -0,0 +1,262 @@
+#pragma once
+
+#include <windows.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cwchar>
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace wndkit::widgets {
+
+/*
+   Fonts, brushes and pens shared by every window in the process.
+
+   An object is looked up by what it is (a LOGFONTW and DPI, a color, a pen style), so
+   widgets asking for the same font or color get the same handle instead of creating their
+   own. Handles are reference counted: an object is kept while a `handle` refers to it and
+   for a while after, so an object that is released and asked for again is not recreated.
+
+   The number of objects is kept within a budget: when it is exceeded, the objects no
+   longer referred to are deleted, least recently released first. Objects in use are never
+   deleted, so the budget can be exceeded when more objects are in use than it allows.
+*/
+class gdi_cache {
+  struct entry;
+
+public:
+  // a reference to a cached object; the object stays valid while a handle refers to it
+  template<typename Object>
+  class handle {
+  public:
+    handle() = default;
+
+    handle(const handle& other) :
+      entry_(other.entry_) {
+      if (entry_)
+        gdi_cache::instance().add_ref(entry_);
+    }
+
+    handle(handle&& other) noexcept :
+      entry_(std::exchange(other.entry_, nullptr)) {
+    }
+
+    handle& operator=(handle other) noexcept {
+      std::swap(entry_, other.entry_);
+      return *this;
+    }
+
+    ~handle() {
+      reset();
+    }
+
+    void reset() {
+      if (entry_)
+        gdi_cache::instance().release(std::exchange(entry_, nullptr));
+    }
+
+    Object get() const {
+      return entry_ ? static_cast<Object>(entry_->object) : nullptr;
+    }
+
+    explicit operator bool() const {
+      return entry_ != nullptr;
+    }
+
+  private:
+    friend class gdi_cache;
+
+    explicit handle(entry* entry) :
+      entry_(entry) {
+    }
+
+    entry* entry_{};
+  };
+
+  using font_handle = handle<HFONT>;
+  using brush_handle = handle<HBRUSH>;
+  using pen_handle = handle<HPEN>;
+
+  struct statistics {
+    uint64_t hits{};      // lookups that found an existing object
+    uint64_t misses{};    // lookups that created an object
+    uint64_t evictions{}; // unused objects deleted to stay within the budget
+    size_t objects{};     // the objects currently cached
+    size_t in_use{};      // the cached objects referred to by a handle
+  };
+
+  static constexpr size_t default_budget = 512;
+
+  static gdi_cache& instance() {
+    static gdi_cache cache;
+    return cache;
+  }
+
+  gdi_cache(const gdi_cache&) = delete;
+  gdi_cache& operator=(const gdi_cache&) = delete;
+
+  // `log_font` describes the font at `dpi` (its height already scaled); empty if the font cannot be created
+  font_handle font(const LOGFONTW& log_font, UINT dpi) {
+    auto key = make_key(kind::font);
+    key.dpi = dpi;
+    std::memcpy(&key.log_font, &log_font, offsetof(LOGFONTW, lfFaceName));
+    // only the name is compared, not what follows its terminator
+    std::wcsncpy(key.log_font.lfFaceName, log_font.lfFaceName, LF_FACESIZE - 1);
+
+    return font_handle(acquire(key, [&] { return CreateFontIndirectW(&key.log_font); }));
+  }
+
+  brush_handle solid_brush(COLORREF color) {
+    auto key = make_key(kind::brush);
+    key.color = color;
+
+    return brush_handle(acquire(key, [&] { return CreateSolidBrush(color); }));
+  }
+
+  pen_handle pen(int style, int width, COLORREF color) {
+    auto key = make_key(kind::pen);
+    key.style = style;
+    key.width = width;
+    key.color = color;
+
+    return pen_handle(acquire(key, [&] { return CreatePen(style, width, color); }));
+  }
+
+  // the number of objects to keep; unused objects beyond it are deleted
+  void set_budget(size_t objects) {
+    std::lock_guard lock(mutex_);
+    budget_ = objects;
+    evict();
+  }
+
+  size_t budget() const {
+    std::lock_guard lock(mutex_);
+    return budget_;
+  }
+
+  // deletes every object not in use
+  void trim() {
+    std::lock_guard lock(mutex_);
+    while (!unused_.empty())
+      evict_oldest();
+  }
+
+  statistics stats() const {
+    std::lock_guard lock(mutex_);
+    auto result = statistics_;
+    result.objects = entries_.size();
+    result.in_use = entries_.size() - unused_.size();
+    return result;
+  }
+
+  void reset_statistics() {
+    std::lock_guard lock(mutex_);
+    statistics_ = {};
+  }
+
+private:
+  gdi_cache() = default;
+
+  enum class kind : uint32_t {
+    font,
+    brush,
+    pen,
+  };
+
+  // compared bytewise, so it is zeroed before it is filled in (see `make_key`)
+  struct key {
+    kind type;
+    UINT dpi;
+    COLORREF color;
+    int style;
+    int width;
+    LOGFONTW log_font;
+
+    bool operator<(const key& other) const {
+      return std::memcmp(this, &other, sizeof(key)) < 0;
+    }
+  };
+
+  struct entry {
+    HGDIOBJ object{};
+    const key* map_key{};  // the entry's key in the map
+    size_t references{};
+    std::list<const key*>::iterator unused_position; // valid while `references` is 0
+  };
+
+  static key make_key(kind type) {
+    key result;
+    std::memset(&result, 0, sizeof(result));
+    result.type = type;
+    return result;
+  }
+
+  template<typename Create>
+  entry* acquire(const key& key, Create&& create) {
+    std::lock_guard lock(mutex_);
+
+    if (auto it = entries_.find(key); it != entries_.end()) {
+      ++statistics_.hits;
+      add_ref_locked(&it->second);
+      return &it->second;
+    }
+
+    HGDIOBJ object = create();
+    if (!object)
+      return nullptr;
+
+    ++statistics_.misses;
+    auto [it, _] = entries_.try_emplace(key);
+    auto& added = it->second;
+    added.object = object;
+    added.map_key = &it->first;
+    added.references = 1;
+    evict();
+    return &added;
+  }
+
+  void add_ref(entry* entry) {
+    std::lock_guard lock(mutex_);
+    add_ref_locked(entry);
+  }
+
+  void add_ref_locked(entry* entry) {
+    if (entry->references++ == 0)
+      unused_.erase(entry->unused_position);
+  }
+
+  void release(entry* released) {
+    std::lock_guard lock(mutex_);
+    if (--released->references > 0)
+      return;
+
+    released->unused_position = unused_.insert(unused_.end(), released->map_key);
+    evict();
+  }
+
+  // deletes unused objects until the budget is met (or none are left)
+  void evict() {
+    while (entries_.size() > budget_ && !unused_.empty()) {
+      evict_oldest();
+      ++statistics_.evictions;
+    }
+  }
+
+  void evict_oldest() {
+    auto it = entries_.find(*unused_.front());
+    unused_.pop_front();
+    DeleteObject(it->second.object);
+    entries_.erase(it);
+  }
+
+  mutable std::mutex mutex_;
+  std::map<key, entry> entries_;
+  std::list<const key*> unused_; // the keys of the objects not in use, least recently released first
+  size_t budget_{default_budget};
+  statistics statistics_;
+};
+
+}
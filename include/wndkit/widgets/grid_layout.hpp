@@ -0,0 +1,55 @@
+#pragma once
+
+#include "layout.hpp"
+#include "core/grid_layout.hpp"
+
+namespace wndkit::widgets {
+
+class grid_layout : public layout {
+public:
+  using track = core::grid_track;
+  using cell = core::grid_cell;
+
+  grid_layout(std::vector<track> columns, std::vector<track> rows)
+    : layout(std::make_unique<core::grid_layout>(std::move(columns), std::move(rows))),
+      grid_(static_cast<core::grid_layout*>(&core_layout())) {
+  }
+
+  using layout::add_widget;
+  using layout::add_layout;
+  using layout::add_element;
+
+  auto& add_widget(HWND hwnd, const cell& cell, alignment_flag align = alignment_flag::none, std::optional<SIZE> size_dlu = {}, const item_options& options = {}) {
+    if (size_dlu.has_value()) {
+      grid_->add_widget(to_handle(hwnd), cell, align, to_core(size_dlu.value()), options);
+    } else {
+      window_metrics metrics(hwnd);
+      grid_->add_widget(to_handle(hwnd), cell, align, metrics, options);
+    }
+
+    return *this;
+  }
+
+  auto& add_layout(std::unique_ptr<layout> layout, const cell& cell, alignment_flag align = alignment_flag::none, const item_options& options = {}) {
+    grid_->add_layout(adopt(std::move(layout)), cell, align, options);
+    return *this;
+  }
+
+  auto& add_element(element& element, const cell& cell, alignment_flag align = alignment_flag::none, std::optional<SIZE> size_dlu = {}, const item_options& options = {}) {
+    grid_->add_layout(make_element_node(element, size_dlu), cell, align, options);
+    return *this;
+  }
+
+  void set_columns(std::vector<track> columns) {
+    grid_->set_columns(std::move(columns));
+  }
+
+  void set_rows(std::vector<track> rows) {
+    grid_->set_rows(std::move(rows));
+  }
+
+private:
+  core::grid_layout* grid_;
+};
+
+}
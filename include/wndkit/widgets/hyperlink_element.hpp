@@ -0,0 +1,101 @@
+#pragma once
+
+#include <windows.h>
+#include <shellapi.h>
+#include <optional>
+#include <string>
+#include "element.hpp"
+
+namespace wndkit::widgets {
+
+// a windowless version of `hyperlink`: a line of colored text that opens a URL when clicked
+class hyperlink_element : public element {
+public:
+  hyperlink_element() = default;
+
+  void set_text(const std::wstring& text) {
+    text_ = text;
+    invalidate();
+    invalidate_size();
+  }
+
+  auto text() const {
+    return text_;
+  }
+
+  void set_url(const std::wstring& url) {
+    url_ = url;
+
+    if (text_.empty() || text_ == url)
+      set_text(url_);
+  }
+
+  auto url() const {
+    return url_;
+  }
+
+  // the size of the text
+  std::optional<SIZE> content_size() const override {
+    auto extent = measure_text(text_.empty() ? url_ : text_, DT_SINGLELINE | DT_NOPREFIX);
+    if (!extent)
+      return {};
+
+    return extent->size;
+  }
+
+protected:
+  void paint(HDC hdc) override {
+    COLORREF color{};
+    if (hovered_)
+      color = hover_color_;
+    else if (visited_)
+      color = visited_color_;
+    else
+      color = unvisited_color_;
+
+    SetTextColor(hdc, color);
+    const std::wstring& text = text_.empty() ? url_ : text_;
+
+    auto area = bounds();
+    DrawTextW(hdc, text.c_str(), static_cast<int>(text.length()), &area, DT_SINGLELINE | DT_VCENTER | DT_LEFT | DT_NOPREFIX);
+  }
+
+  std::wstring tooltip_text() const override {
+    return url_;
+  }
+
+  HCURSOR cursor() const override {
+    return LoadCursorW(nullptr, reinterpret_cast<LPCWSTR>(IDC_HAND));
+  }
+
+  void on_mouse_enter() override {
+    hovered_ = true;
+    invalidate();
+  }
+
+  void on_mouse_leave() override {
+    hovered_ = false;
+    invalidate();
+  }
+
+  void on_click() override {
+    visited_ = true;
+    invalidate();
+
+    if (!url_.empty())
+      ShellExecuteW(nullptr, L"open", url_.c_str(), nullptr, nullptr, SW_SHOWNORMAL);
+  }
+
+private:
+  static constexpr COLORREF unvisited_color_ = RGB(0x00, 0x00, 0xEE);
+  static constexpr COLORREF visited_color_   = RGB(0x55, 0x1A, 0x8B);
+  static constexpr COLORREF hover_color_     = RGB(0xFF, 0x00, 0x00);
+
+  bool visited_{};
+  bool hovered_{};
+
+  std::wstring text_;
+  std::wstring url_;
+};
+
+}
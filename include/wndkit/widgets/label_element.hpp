@@ -0,0 +1,60 @@
+#pragma once
+
+#include <windows.h>
+#include <optional>
+#include <string>
+#include "element.hpp"
+
+namespace wndkit::widgets {
+
+// a windowless line of static text
+class label_element : public element {
+public:
+  label_element() = default;
+
+  explicit label_element(std::wstring text) :
+    text_(std::move(text)) {
+  }
+
+  void set_text(std::wstring text) {
+    if (text_ == text)
+      return;
+
+    text_ = std::move(text);
+    invalidate();
+    invalidate_size();
+  }
+
+  const std::wstring& text() const {
+    return text_;
+  }
+
+  // DT_* flags for the text's horizontal alignment
+  void set_format(UINT format) {
+    format_ = format;
+    invalidate();
+  }
+
+  // the size of the text
+  std::optional<SIZE> content_size() const override {
+    auto extent = measure_text(text_, DT_SINGLELINE | DT_NOPREFIX | format_);
+    if (!extent)
+      return {};
+
+    return extent->size;
+  }
+
+protected:
+  void paint(HDC hdc) override {
+    SetTextColor(hdc, GetSysColor(COLOR_WINDOWTEXT));
+
+    auto area = bounds();
+    DrawTextW(hdc, text_.c_str(), static_cast<int>(text_.length()), &area, DT_SINGLELINE | DT_VCENTER | DT_NOPREFIX | format_);
+  }
+
+private:
+  std::wstring text_;
+  UINT format_{DT_LEFT};
+};
+
+}
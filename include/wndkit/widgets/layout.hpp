@@ -1,216 +1,316 @@
-#pragma once
-
-#include <windows.h>
-#include <commctrl.h>
-#include <cstdint>
-#include <memory>
-#include <optional>
-#include <string>
-#include <vector>
-#include <wil/resource.h>
-#include "hyperlink.hpp"
-
-namespace wndkit::widgets {
-
-class layout {
-public:
-  enum class alignment_flag : uint32_t {
-    none          = 0x0,
-    align_left    = 0x1,
-    align_right   = 0x2,
-    align_hcenter = 0x4,
-    align_top     = 0x8,
-    align_bottom  = 0x10,
-    align_vcenter = 0x20,
-    align_center  = align_hcenter | align_vcenter
-  };
-
-  friend constexpr alignment_flag operator|(alignment_flag lhs, alignment_flag rhs) noexcept {
-    using utype = std::underlying_type_t<alignment_flag>;
-    return static_cast<alignment_flag>(
-      static_cast<utype>(lhs) | static_cast<utype>(rhs)
-    );
-  }
-
-  friend constexpr alignment_flag operator&(alignment_flag lhs, alignment_flag rhs) noexcept {
-    using utype = std::underlying_type_t<alignment_flag>;
-    return static_cast<alignment_flag>(
-      static_cast<utype>(lhs) & static_cast<utype>(rhs)
-    );
-  }
-
-  explicit layout()
-    : layout({4, 4}) {
-  }
-
-  explicit layout(SIZE spacing_dlu) :
-    spacing_dlu_(spacing_dlu) {
-  }
-
-  void set_margin(SIZE margin_dlu) {
-    margin_dlu_ = margin_dlu;
-  }
-
-  auto& add_widget(HWND hwnd, alignment_flag align = alignment_flag::none, std::optional<SIZE> size_dlu = {}) {
-    if (!size_dlu.has_value())
-      size_dlu = get_standard_control_size_dlu(hwnd);
-
-    assert(size_dlu.has_value());
-    items_.push_back(std::make_unique<widget_child_item>(align, hwnd, size_dlu.value()));
-
-    return *this;
-  }
-
-  auto& add_layout(std::unique_ptr<layout> layout, alignment_flag align = alignment_flag::none) {
-    items_.push_back(std::make_unique<layout_child_item>(align, std::move(layout)));
-
-    return *this;
-  }
-
-  void set_font(HWND hwnd, HFONT font) {
-    auto hdc = wil::GetDC(hwnd);
-    auto old_font = wil::SelectObject(hdc.get(), font);
-
-    TEXTMETRICW tm;
-    if (GetTextMetricsW(hdc.get(), &tm))
-      set_font_size({tm.tmAveCharWidth, tm.tmHeight});
-  }
-
-  void resize(const RECT& area) {
-    auto hdwp = BeginDeferWindowPos(0);
-    resize(hdwp, area);
-    EndDeferWindowPos(hdwp);
-  }
-
-  virtual SIZE calc_size() const = 0;
-
-protected:
-  virtual void resize(HDWP& hdwp, const RECT& area) = 0;
-
-  void set_font_size(SIZE size) {
-    font_size_ = size;
-
-    for (auto& item : items_)
-      item->set_font_size(font_size_);
-  }
-
-  class child_item {
-  public:
-    child_item(alignment_flag alignment) :
-      alignment_(alignment) {
-    }
-
-    auto alignment() const {
-      return alignment_;
-    }
-
-    virtual SIZE calc_size() = 0;
-    virtual void resize(HDWP& hwdp, RECT area) = 0;
-    virtual void set_font_size(SIZE size) = 0;
-
-  private:
-    alignment_flag alignment_;
-  };
-
-  class widget_child_item : public child_item {
-  public:
-    widget_child_item(alignment_flag alignment, HWND hwnd, SIZE size_dlu) :
-      child_item(alignment),
-      hwnd_(hwnd),
-      size_dlu_(size_dlu) {
-    }
-
-    auto hwnd() {
-      return hwnd_;
-    }
-
-    SIZE calc_size() override {
-      return size_dlu_;
-    }
-
-    void resize(HDWP& hdwp, RECT area) override {
-      hdwp = DeferWindowPos(hdwp, hwnd_, 0, area.left, area.top, area.right - area.left, area.bottom - area.top, SWP_NOZORDER);
-    }
-
-    void set_font_size(SIZE) override {}
-
-  private:
-    HWND hwnd_;
-    SIZE size_dlu_;
-  };
-
-  class layout_child_item : public child_item {
-  public:
-    layout_child_item(alignment_flag alignment, std::unique_ptr<layout> layout) :
-      child_item(alignment),
-      layout_(std::move(layout)) {
-    }
-
-    SIZE calc_size() override {
-      return layout_->calc_size();
-    }
-
-    void resize(HDWP& hdwp, RECT area) override {
-      layout_->resize(hdwp, area);
-    }
-
-    void set_font_size(SIZE size) override {
-      layout_->set_font_size(size);
-    }
-
-  private:
-    std::unique_ptr<layout> layout_;
-  };
-
-  static std::optional<SIZE> get_standard_control_size_dlu(HWND hwnd) {
-    std::wstring class_name(64, L'\0');
-    class_name.resize(GetClassNameW(hwnd, class_name.data(), class_name.size()));
-
-    auto style = static_cast<DWORD>(GetWindowLongPtr(hwnd, GWL_STYLE));
-
-    if (class_name == WC_BUTTONW) {
-      switch (style & 0xF) { // lower 4 bits are the BS_* type
-        case BS_CHECKBOX:
-        case BS_AUTOCHECKBOX:
-        case BS_3STATE:
-        case BS_AUTO3STATE:
-        case BS_RADIOBUTTON:
-        case BS_AUTORADIOBUTTON:
-          return {{10, 10}};
-
-        case BS_GROUPBOX:
-          return {{50, 28}};
-
-        default:
-          return {{50, 14}};
-      }
-    } else if (class_name == WC_EDITW) {
-      return {{50, 14}};
-    } else if (class_name == WC_STATICW) {
-      return {{50, 8}};
-    } else if (class_name == WC_LISTBOXW) {
-      return {{50, 50}};
-    } else if (class_name == WC_SCROLLBARW) {
-      return {{16, 70}};
-    } else if (class_name == hyperlink::class_name()) {
-      return {{50, 8}};
-    }
-
-    return {};
-  }
-
-  // Compute base unit size (DLU)
-  SIZE to_pixels(SIZE dlu) {
-    return {
-      MulDiv(dlu.cx, font_size_.cx, 4),
-      MulDiv(dlu.cy, font_size_.cy, 8)
-    };
-  }
-
-  SIZE font_size_{};
-  std::vector<std::unique_ptr<child_item>> items_;
-  SIZE margin_dlu_{};
-  SIZE spacing_dlu_{};
-};
-
-}
+#pragma once
+
+#include <windows.h>
+#include <commctrl.h>
+#include <cassert>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <wil/resource.h>
+#include "control_sizes.hpp"
+#include "element.hpp"
+#include "font_metrics_cache.hpp"
+#include "hyperlink.hpp"
+#include "core/layout.hpp"
+#include "core/spatial_index.hpp"
+
+namespace wndkit::widgets {
+
+// moves child windows to the rectangles computed by a layout; moves are batched with DeferWindowPos unless `defer` is false
+// (each rectangle is also recorded in `index`, if given)
+class window_placement : public core::placement_sink {
+public:
+  window_placement(size_t capacity, bool defer, core::spatial_index* index = nullptr) :
+    capacity_(static_cast<int>(capacity)),
+    defer_(defer),
+    index_(index) {
+  }
+
+  window_placement(const window_placement&) = delete;
+  window_placement& operator=(const window_placement&) = delete;
+
+  ~window_placement() override {
+    if (hdwp_)
+      EndDeferWindowPos(hdwp_);
+  }
+
+  void place(core::item_handle item, const core::rect& area) override {
+    if (index_)
+      index_->set(item, area);
+
+    auto hwnd = reinterpret_cast<HWND>(item);
+    if (!defer_) {
+      SetWindowPos(hwnd, nullptr, area.left, area.top, area.width(), area.height(), SWP_NOZORDER);
+      return;
+    }
+
+    if (failed_)
+      return;
+
+    // nothing is deferred (or redrawn) when no widget moved
+    if (!hdwp_)
+      hdwp_ = BeginDeferWindowPos(capacity_);
+    if (hdwp_)
+      hdwp_ = DeferWindowPos(hdwp_, hwnd, nullptr, area.left, area.top, area.width(), area.height(), SWP_NOZORDER);
+
+    failed_ = !hdwp_;
+  }
+
+  bool failed() const {
+    return failed_;
+  }
+
+private:
+  HDWP hdwp_{};
+  int capacity_;
+  bool defer_;
+  core::spatial_index* index_;
+  bool failed_{};
+};
+
+// measures fonts and standard controls for a layout
+class window_metrics : public core::metrics_provider {
+public:
+  // `hwnd` is the window whose device context fonts are measured with
+  explicit window_metrics(HWND hwnd = nullptr) :
+    hwnd_(hwnd) {
+  }
+
+  std::optional<core::size> font_size(core::font_handle font) override {
+    auto dpi = hwnd_ ? GetDpiForWindow(hwnd_) : GetDpiForSystem();
+    return font_metrics_cache::instance().font_size(hwnd_, reinterpret_cast<HFONT>(font), dpi);
+  }
+
+  std::optional<core::size> default_size(core::item_handle item) override {
+    auto size = control_sizes::instance().default_size(reinterpret_cast<HWND>(item));
+    if (!size)
+      return {};
+
+    return core::size{size->cx, size->cy};
+  }
+
+private:
+  HWND hwnd_;
+};
+
+/*
+   Lays out child windows.
+
+   This is a thin adapter over a window-system independent `core::layout`: it converts
+   between HWND/SIZE/RECT and the core types, measures fonts and standard controls with
+   `window_metrics`, and applies the computed rectangles with `window_placement`.
+*/
+class layout {
+public:
+  using alignment_flag = core::alignment_flag;
+  using engine = core::layout::engine;
+  using resize_result = core::layout::resize_result;
+  using item_options = core::layout::item_options;
+
+  virtual ~layout() = default;
+
+  layout(const layout&) = delete;
+  layout& operator=(const layout&) = delete;
+
+  void set_margin(SIZE margin_dlu) {
+    node_->set_margin(to_core(margin_dlu));
+  }
+
+  auto& add_widget(HWND hwnd, alignment_flag align = alignment_flag::none, std::optional<SIZE> size_dlu = {}, const item_options& options = {}) {
+    if (size_dlu.has_value()) {
+      node_->add_widget(to_handle(hwnd), align, to_core(size_dlu.value()), options);
+    } else {
+      window_metrics metrics(hwnd);
+      node_->add_widget(to_handle(hwnd), align, metrics, options);
+    }
+
+    return *this;
+  }
+
+  auto& add_layout(std::unique_ptr<layout> layout, alignment_flag align = alignment_flag::none, const item_options& options = {}) {
+    node_->add_layout(adopt(std::move(layout)), align, options);
+    return *this;
+  }
+
+  // adds a windowless element; the element must outlive the layout
+  // (without a size, the element is sized to its content, see `element::content_size`)
+  auto& add_element(element& element, alignment_flag align = alignment_flag::none, std::optional<SIZE> size_dlu = {}, const item_options& options = {}) {
+    node_->add_layout(make_element_node(element, size_dlu), align, options);
+    return *this;
+  }
+
+  // adds empty space; a spacer with a stretch takes a share of the free space
+  auto& add_spacer(SIZE size_dlu, int32_t stretch = 0) {
+    node_->add_spacer(to_core(size_dlu), stretch);
+    return *this;
+  }
+
+  // adds empty space that only takes a share of the free space
+  auto& add_stretch(int32_t stretch = 1) {
+    node_->add_stretch(stretch);
+    return *this;
+  }
+
+  // removes a widget from this layout (or a nested layout), leaving the window where it is;
+  // returns false if the widget was not found
+  bool remove_widget(HWND hwnd) {
+    if (!node_->remove_widget(to_handle(hwnd)))
+      return false;
+
+    // the widget was indexed by the outermost layout that resized it
+    for (auto l = this; l; l = l->parent_)
+      l->hit_index_.remove(to_handle(hwnd));
+    return true;
+  }
+
+  // changes the size hint of a widget in this layout (or a nested layout); returns false if the widget was not found
+  bool set_widget_size(HWND hwnd, SIZE size_dlu) {
+    return node_->set_widget_size(to_handle(hwnd), to_core(size_dlu));
+  }
+
+  void set_font(HWND hwnd, HFONT font) {
+    window_metrics metrics(hwnd);
+    node_->set_font(metrics, reinterpret_cast<core::font_handle>(font));
+  }
+
+  /*
+     Defers resizing while widgets are added, removed or resized.
+
+     Resizes requested while the scope is open are not run; when the last open scope
+     closes, the layout is measured and resized once, to the last requested area.
+
+       {
+         auto update = layout.update();
+         layout.add_widget(...).add_widget(...);
+         layout.resize(area);
+       } // laid out here
+  */
+  class update_scope {
+  public:
+    explicit update_scope(layout& layout) :
+      layout_(layout) {
+      ++layout_.update_depth_;
+    }
+
+    update_scope(const update_scope&) = delete;
+    update_scope& operator=(const update_scope&) = delete;
+
+    ~update_scope() {
+      if (--layout_.update_depth_ == 0 && layout_.pending_area_) {
+        auto area = *layout_.pending_area_;
+        layout_.pending_area_.reset();
+        layout_.resize(area);
+      }
+    }
+
+  private:
+    layout& layout_;
+  };
+
+  [[nodiscard]] update_scope update() {
+    return update_scope(*this);
+  }
+
+  bool updating() const {
+    return update_depth_ > 0;
+  }
+
+  // positions the widgets within `area`, moving only those whose rectangle changed since the last resize
+  // (within an update scope the resize is deferred until the scope closes, and nothing is moved)
+  resize_result resize(const RECT& area) {
+    if (updating()) {
+      pending_area_ = area;
+      return {};
+    }
+
+    {
+      window_placement deferred(node_->widget_count(), true, &hit_index_);
+      auto result = node_->resize(to_core(area), deferred);
+      if (!deferred.failed())
+        return result;
+    }
+
+    // the deferred moves were abandoned, so move every widget directly
+    node_->reset_placements();
+    window_placement direct(node_->widget_count(), false, &hit_index_);
+    return node_->resize(to_core(area), direct);
+  }
+
+  // the widget whose rectangle (as placed by the last resize) contains `point`, or null
+  HWND widget_at(POINT point) const {
+    auto item = hit_index_.query(point.x, point.y);
+    return item ? reinterpret_cast<HWND>(*item) : nullptr;
+  }
+
+  // selects the engine used when this layout is resized
+  void set_engine(engine engine) {
+    node_->set_engine(engine);
+  }
+
+  // forgets the rectangles applied by previous resizes, so the next resize moves every widget
+  // (for example after the widgets were moved by something other than the layout)
+  void reset_placements() {
+    node_->reset_placements();
+  }
+
+  // returns the space that the layout will take up (in dialog units)
+  SIZE calc_size() const {
+    auto size = node_->calc_size();
+    return {size.cx, size.cy};
+  }
+
+  void invalidate() {
+    node_->invalidate();
+  }
+
+  // the window-system independent layout behind this adapter
+  core::layout& core_layout() {
+    return *node_;
+  }
+
+protected:
+  explicit layout(std::unique_ptr<core::layout> node) :
+    owned_node_(std::move(node)),
+    node_(owned_node_.get()) {
+  }
+
+  // keeps the adapter of a layout being nested in this one and returns its node for the core layout to take
+  std::unique_ptr<core::layout> adopt(std::unique_ptr<layout> layout) {
+    assert(layout->owned_node_);
+
+    auto node = std::move(layout->owned_node_);
+    layout->parent_ = this;
+    children_.push_back(std::move(layout));
+    return node;
+  }
+
+  static std::unique_ptr<core::layout> make_element_node(element& element, std::optional<SIZE> size_dlu) {
+    std::optional<core::size> size;
+    if (size_dlu)
+      size = to_core(*size_dlu);
+    return std::make_unique<element_layout>(element, size);
+  }
+
+  static core::item_handle to_handle(HWND hwnd) {
+    return reinterpret_cast<core::item_handle>(hwnd);
+  }
+
+  static core::size to_core(SIZE size) {
+    return {size.cx, size.cy};
+  }
+
+  static core::rect to_core(const RECT& rect) {
+    return {rect.left, rect.top, rect.right, rect.bottom};
+  }
+
+private:
+  std::unique_ptr<core::layout> owned_node_; // until the layout is added to another layout
+  core::layout* node_;
+  std::vector<std::unique_ptr<layout>> children_;
+  layout* parent_{}; // the layout this one was added to
+  int update_depth_{};
+  std::optional<RECT> pending_area_; // the last resize deferred by an update scope
+  core::spatial_index hit_index_;    // the widgets placed by resizes of this layout
+};
+
+}
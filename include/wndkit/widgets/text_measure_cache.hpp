@@ -0,0 +1,275 @@
+#pragma once
+
+#include <windows.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cwchar>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <wil/resource.h>
+
+namespace wndkit::widgets {
+
+// a line of measured text
+struct text_line {
+  size_t offset{};  // the index of the line's first character
+  size_t length{};  // the number of characters drawn (trailing spaces of wrapped lines are not)
+  int32_t width{};  // in pixels
+};
+
+// the size of a text and where it breaks into lines
+struct text_extent {
+  SIZE size{};                  // in pixels
+  int32_t line_height{};
+  std::vector<text_line> lines;
+};
+
+/*
+   The measured size and line breaks of texts, shared by every widget in the process.
+
+   Measuring text needs a device context and a GetTextExtent call per line, which adds up
+   when labels are sized to their text on every layout pass. Measurements are cached by
+   text, font, DPI, format and width; the least recently used are dropped when the cache
+   is full. As in `font_metrics_cache`, an entry records the font's LOGFONTW so a reused
+   font handle is not mistaken for the font it used to name.
+
+   Texts are measured as DrawTextW lays them out with the same format, for the flags that
+   affect size: DT_SINGLELINE keeps the text on one line; otherwise it breaks at line feeds
+   and, with DT_WORDBREAK and a width, between words to fit the width (a word wider than
+   the width is broken between characters). Prefix characters are measured as written.
+*/
+class text_measure_cache {
+public:
+  struct statistics {
+    uint64_t hits{};
+    uint64_t misses{};
+    uint64_t evictions{};
+
+    double hit_rate() const {
+      auto lookups = hits + misses;
+      return lookups ? static_cast<double>(hits) / lookups : 0.0;
+    }
+  };
+
+  static constexpr size_t default_capacity = 2048;
+
+  static text_measure_cache& instance() {
+    static text_measure_cache cache;
+    return cache;
+  }
+
+  text_measure_cache(const text_measure_cache&) = delete;
+  text_measure_cache& operator=(const text_measure_cache&) = delete;
+
+  // the extent of `text` drawn with `font` at `dpi` and the DT_* `format`, measured with the device context of `hwnd`
+  // if not cached; `max_width` (in pixels) is the width that DT_WORDBREAK wraps to; null if it cannot be measured
+  std::shared_ptr<const text_extent> measure(HWND hwnd, HFONT font, UINT dpi, std::wstring_view text, UINT format, int32_t max_width = 0) {
+    LOGFONTW log_font{};
+    if (font && !GetObjectW(font, sizeof(log_font), &log_font))
+      return nullptr;
+
+    format &= DT_SINGLELINE | DT_WORDBREAK;
+    if (!(format & DT_WORDBREAK) || (format & DT_SINGLELINE))
+      max_width = 0;
+
+    key key{std::hash<std::wstring_view>{}(text), font, dpi, format, max_width};
+    {
+      std::lock_guard lock(mutex_);
+      if (auto it = index_.find(key); it != index_.end()) {
+        auto& entry = *it->second;
+        if (entry.text == text && same_font(entry.log_font, log_font)) {
+          ++statistics_.hits;
+          entries_.splice(entries_.begin(), entries_, it->second);
+          return entry.extent;
+        }
+      }
+      ++statistics_.misses;
+    }
+
+    auto extent = measure_text(hwnd, font, text, format, max_width);
+    if (!extent)
+      return nullptr;
+
+    std::lock_guard lock(mutex_);
+    if (auto it = index_.find(key); it != index_.end()) {
+      // measured again because the text, or the font behind the handle, is different
+      entries_.erase(it->second);
+      index_.erase(it);
+    }
+
+    entries_.push_front({key, std::wstring(text), log_font, extent});
+    index_.emplace(key, entries_.begin());
+    trim();
+    return extent;
+  }
+
+  // the number of measurements kept
+  void set_capacity(size_t entries) {
+    std::lock_guard lock(mutex_);
+    capacity_ = std::max<size_t>(entries, 1);
+    trim();
+  }
+
+  size_t size() const {
+    std::lock_guard lock(mutex_);
+    return entries_.size();
+  }
+
+  // forgets every measurement (for example when the system fonts or the DPI changed)
+  void clear() {
+    std::lock_guard lock(mutex_);
+    index_.clear();
+    entries_.clear();
+  }
+
+  statistics stats() const {
+    std::lock_guard lock(mutex_);
+    return statistics_;
+  }
+
+  void reset_statistics() {
+    std::lock_guard lock(mutex_);
+    statistics_ = {};
+  }
+
+private:
+  text_measure_cache() = default;
+
+  struct key {
+    size_t text_hash;
+    HFONT font;
+    UINT dpi;
+    UINT format;
+    int32_t max_width;
+
+    bool operator==(const key&) const = default;
+  };
+
+  struct key_hash {
+    size_t operator()(const key& key) const {
+      auto hash = key.text_hash;
+      for (auto value : {reinterpret_cast<size_t>(key.font), size_t{key.dpi}, size_t{key.format}, static_cast<size_t>(key.max_width)})
+        hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+      return hash;
+    }
+  };
+
+  struct entry {
+    key lookup;
+    std::wstring text;
+    LOGFONTW log_font;
+    std::shared_ptr<const text_extent> extent;
+  };
+
+  static bool same_font(const LOGFONTW& a, const LOGFONTW& b) {
+    return std::memcmp(&a, &b, offsetof(LOGFONTW, lfFaceName)) == 0 && std::wcscmp(a.lfFaceName, b.lfFaceName) == 0;
+  }
+
+  static std::shared_ptr<const text_extent> measure_text(HWND hwnd, HFONT font, std::wstring_view text, UINT format, int32_t max_width) {
+    auto hdc = wil::GetDC(hwnd);
+    if (!hdc)
+      return nullptr;
+
+    auto old_font = wil::SelectObject(hdc.get(), font ? font : static_cast<HFONT>(GetStockObject(DEFAULT_GUI_FONT)));
+
+    TEXTMETRICW tm;
+    if (!GetTextMetricsW(hdc.get(), &tm))
+      return nullptr;
+
+    auto extent = std::make_shared<text_extent>();
+    extent->line_height = tm.tmHeight;
+
+    auto width_of = [&](size_t offset, size_t length) {
+      SIZE size{};
+      GetTextExtentPoint32W(hdc.get(), text.data() + offset, static_cast<int>(length), &size);
+      return static_cast<int32_t>(size.cx);
+    };
+
+    auto add_line = [&](size_t offset, size_t length) {
+      extent->lines.push_back({offset, length, length ? width_of(offset, length) : 0});
+    };
+
+    if (format & DT_SINGLELINE) {
+      add_line(0, text.size());
+    } else {
+      size_t start = 0;
+      while (true) {
+        auto end = std::min(text.find(L'\n', start), text.size());
+        auto length = end - start;
+        if (length && text[end - 1] == L'\r')
+          --length;
+
+        if (max_width > 0)
+          wrap(hdc.get(), text, start, length, max_width, add_line);
+        else
+          add_line(start, length);
+
+        if (end == text.size())
+          break;
+        start = end + 1;
+      }
+    }
+
+    for (const auto& line : extent->lines)
+      extent->size.cx = std::max<LONG>(extent->size.cx, line.width);
+    extent->size.cy = static_cast<LONG>(extent->lines.size()) * tm.tmHeight;
+    return extent;
+  }
+
+  // breaks the paragraph [start, start + length) into lines no wider than `max_width`
+  template<typename AddLine>
+  static void wrap(HDC hdc, std::wstring_view text, size_t start, size_t length, int32_t max_width, AddLine&& add_line) {
+    auto end = start + length;
+    if (start == end) {
+      add_line(start, 0);
+      return;
+    }
+
+    while (start < end) {
+      int fit = 0;
+      SIZE size{};
+      GetTextExtentExPointW(hdc, text.data() + start, static_cast<int>(end - start), max_width, &fit, nullptr, &size);
+
+      auto line_end = end;
+      if (start + fit < end) {
+        // break after the last space that fits, or within the word if there is none
+        auto space = text.substr(start, fit + 1).find_last_of(L' ');
+        line_end = space != std::wstring_view::npos && space > 0 ? start + space : start + std::max(fit, 1);
+      }
+
+      auto drawn = line_end;
+      while (drawn > start && text[drawn - 1] == L' ')
+        --drawn;
+      add_line(start, drawn - start);
+
+      start = line_end;
+      while (start < end && text[start] == L' ')
+        ++start;
+    }
+  }
+
+  // drops the least recently used measurements beyond the capacity
+  void trim() {
+    while (entries_.size() > capacity_) {
+      index_.erase(entries_.back().lookup);
+      entries_.pop_back();
+      ++statistics_.evictions;
+    }
+  }
+
+  mutable std::mutex mutex_;
+  std::list<entry> entries_; // the most recently used first
+  std::unordered_map<key, std::list<entry>::iterator, key_hash> index_;
+  size_t capacity_{default_capacity};
+  statistics statistics_;
+};
+
+}
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <windows.h>
+#include <commctrl.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace wndkit::widgets {
+
+/*
+   One tooltip window shared by all the tools of a top-level window.
+
+   Tools are registered either by window (the tooltip shows while the mouse is over that
+   window) or by a rectangle within a window (for windowless elements). The text is not
+   copied into the tooltip: it is asked for with TTN_GETDISPINFO when the tooltip is about
+   to show, so a tool whose text changes needs no update.
+
+   The manager of a top-level window is created by `for_window` on first use and destroyed
+   with the window. It subclasses the windows that receive the tooltip's notifications (the
+   top-level window, and the windows that rectangle tools belong to).
+*/
+class tooltip_manager {
+public:
+  // returns the text of a tool when its tooltip is about to show
+  using text_provider = std::function<std::wstring()>;
+
+  tooltip_manager(const tooltip_manager&) = delete;
+  tooltip_manager& operator=(const tooltip_manager&) = delete;
+
+  // the manager of the top-level window that `hwnd` belongs to, created if needed
+  static tooltip_manager& for_window(HWND hwnd) {
+    if (auto manager = find(hwnd))
+      return *manager;
+
+    auto root = GetAncestor(hwnd, GA_ROOT);
+    if (!root)
+      throw std::system_error(static_cast<int>(GetLastError()), std::system_category());
+
+    // owned by the window's subclass, which deletes it when the window is destroyed
+    auto manager = new tooltip_manager(root);
+    SetPropW(root, property_name(), manager);
+    return *manager;
+  }
+
+  // the manager of the top-level window that `hwnd` belongs to, or null if it has none
+  static tooltip_manager* find(HWND hwnd) {
+    auto root = GetAncestor(hwnd, GA_ROOT);
+    return root ? static_cast<tooltip_manager*>(GetPropW(root, property_name())) : nullptr;
+  }
+
+  // adds (or updates the text of) a tool covering the window `tool`
+  void add_tool(HWND tool, text_provider text) {
+    auto [it, added] = tools_.insert_or_assign({root_, reinterpret_cast<UINT_PTR>(tool)}, std::move(text));
+    if (!added)
+      return;
+
+    auto ti = tool_info(root_, reinterpret_cast<UINT_PTR>(tool));
+    ti.uFlags |= TTF_IDISHWND | TTF_SUBCLASS;
+    SendMessageW(tooltip_, TTM_ADDTOOLW, 0, reinterpret_cast<LPARAM>(&ti));
+  }
+
+  // adds (or updates the text of) a tool covering `area` in the client area of `owner`; `id` identifies it within `owner`
+  void add_tool(HWND owner, UINT_PTR id, const RECT& area, text_provider text) {
+    auto [it, added] = tools_.insert_or_assign({owner, id}, std::move(text));
+    if (!added) {
+      set_tool_rect(owner, id, area);
+      return;
+    }
+
+    if (owner != root_)
+      watch(owner);
+
+    auto ti = tool_info(owner, id);
+    ti.uFlags |= TTF_SUBCLASS;
+    ti.rect = area;
+    SendMessageW(tooltip_, TTM_ADDTOOLW, 0, reinterpret_cast<LPARAM>(&ti));
+  }
+
+  // moves a rectangle tool
+  void set_tool_rect(HWND owner, UINT_PTR id, const RECT& area) {
+    auto ti = tool_info(owner, id);
+    ti.rect = area;
+    SendMessageW(tooltip_, TTM_NEWTOOLRECTW, 0, reinterpret_cast<LPARAM>(&ti));
+  }
+
+  void remove_tool(HWND tool) {
+    remove_tool(root_, reinterpret_cast<UINT_PTR>(tool));
+  }
+
+  void remove_tool(HWND owner, UINT_PTR id) {
+    if (!tools_.erase({owner, id}))
+      return;
+
+    auto ti = tool_info(owner, id);
+    SendMessageW(tooltip_, TTM_DELTOOLW, 0, reinterpret_cast<LPARAM>(&ti));
+  }
+
+  // the number of registered tools, all shown by `tooltip_window`
+  size_t tool_count() const {
+    return tools_.size();
+  }
+
+  // the one tooltip window of the top-level window
+  HWND tooltip_window() const {
+    return tooltip_;
+  }
+
+private:
+  explicit tooltip_manager(HWND root) :
+    root_(root) {
+    tooltip_ = CreateWindowExW(
+        WS_EX_TOPMOST, TOOLTIPS_CLASSW, nullptr,
+        WS_POPUP | TTS_ALWAYSTIP | TTS_NOPREFIX,
+        CW_USEDEFAULT, CW_USEDEFAULT,
+        CW_USEDEFAULT, CW_USEDEFAULT,
+        root_, nullptr,
+        GetModuleHandleW(nullptr), nullptr);
+    if (!tooltip_)
+      throw std::system_error(static_cast<int>(GetLastError()), std::system_category());
+
+    watch(root_);
+  }
+
+  ~tooltip_manager() {
+    for (auto hwnd : watched_)
+      RemoveWindowSubclass(hwnd, &subclass_proc, reinterpret_cast<UINT_PTR>(this));
+
+    RemovePropW(root_, property_name());
+  }
+
+  static constexpr const wchar_t* property_name() {
+    return L"wndkit_tooltip_manager";
+  }
+
+  TOOLINFOW tool_info(HWND owner, UINT_PTR id) const {
+    TOOLINFOW ti{};
+    ti.cbSize   = sizeof(ti);
+    ti.hwnd     = owner;
+    ti.uId      = id;
+    ti.lpszText = LPSTR_TEXTCALLBACKW;
+    return ti;
+  }
+
+  // subclasses a window that receives the tooltip's notifications
+  void watch(HWND hwnd) {
+    if (watched_.contains(hwnd))
+      return;
+
+    if (!SetWindowSubclass(hwnd, &subclass_proc, reinterpret_cast<UINT_PTR>(this), reinterpret_cast<DWORD_PTR>(this)))
+      throw std::system_error(static_cast<int>(GetLastError()), std::system_category());
+
+    watched_.insert(hwnd);
+  }
+
+  // forgets a destroyed window and its tools
+  void forget(HWND hwnd) {
+    RemoveWindowSubclass(hwnd, &subclass_proc, reinterpret_cast<UINT_PTR>(this));
+    watched_.erase(hwnd);
+    std::erase_if(tools_, [hwnd](const auto& tool) { return tool.first.first == hwnd; });
+  }
+
+  // `owner` is the window the notification was sent to: the tool's TOOLINFOW::hwnd
+  bool on_get_disp_info(HWND owner, NMTTDISPINFOW& info) {
+    auto it = tools_.find({owner, info.hdr.idFrom});
+    if (it == tools_.end() || !it->second)
+      return false;
+
+    // the text has to outlive the notification, until the tooltip asks again
+    text_ = it->second();
+    info.lpszText = text_.data();
+    info.szText[0] = L'\0';
+    info.hinst = nullptr;
+    return true;
+  }
+
+  static LRESULT CALLBACK subclass_proc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam, UINT_PTR, DWORD_PTR ref_data) {
+    auto manager = reinterpret_cast<tooltip_manager*>(ref_data);
+
+    if (msg == WM_NOTIFY) {
+      auto& header = *reinterpret_cast<NMHDR*>(lparam);
+      if (header.hwndFrom == manager->tooltip_ && header.code == TTN_GETDISPINFOW) {
+        if (manager->on_get_disp_info(hwnd, *reinterpret_cast<NMTTDISPINFOW*>(lparam)))
+          return 0;
+      }
+    } else if (msg == WM_NCDESTROY) {
+      if (hwnd == manager->root_) {
+        auto result = DefSubclassProc(hwnd, msg, wparam, lparam);
+        delete manager;
+        return result;
+      }
+
+      manager->forget(hwnd);
+    }
+
+    return DefSubclassProc(hwnd, msg, wparam, lparam);
+  }
+
+  HWND root_;
+  HWND tooltip_{};
+  std::map<std::pair<HWND, UINT_PTR>, text_provider> tools_; // by owner and id
+  std::set<HWND> watched_;                                   // the subclassed windows
+  std::wstring text_;                                        // the text of the tooltip being shown
+};
+
+}
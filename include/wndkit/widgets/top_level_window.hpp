@@ -1,116 +1,379 @@
-#pragma once
-
-#include <windows.h>
-#include <shellscalingapi.h>
-#include <memory>
-#include <wil/resource.h>
-#include <wndkit/dispatcher.hpp>
-#include <wndkit/message_handler.hpp>
-#include "layout.hpp"
-
-namespace wndkit::widgets {
-
-class top_level_window {
-public:
-  top_level_window() {
-    message_handler_
-      .on_message<WM_CREATE>([this](HWND hwnd, const create_params& params) {
-        on_create(hwnd, params);
-      })
-      .on_message<WM_DPICHANGED>([this](HWND hwnd, const auto& params) {
-        on_dpi_changed(hwnd, params);
-      })
-      .on_message<WM_SIZE>([this](HWND hwnd, const auto& params) {
-        on_size(hwnd, params);
-      })
-      .on_message<WM_CLOSE>([this](HWND hwnd, const auto& params) {
-        on_close(hwnd, params);
-      })
-      .on_message<WM_CTLCOLORSTATIC>([this](HWND hwnd, const auto& params) {
-        return on_ctl_color_static(hwnd, params);
-      })
-    ;
-  }
-
-  template<typename... Args>
-  auto create(Args&&... args) {
-    return wndkit::dispatcher::create_window(&message_handler_, std::forward<Args>(args)...);
-  }
-
-  layout& layout() { return *layout_.get(); }
-
-  void set_layout(std::unique_ptr<wndkit::widgets::layout> layout) {
-    assert(!layout_);
-    if (!layout_) {
-      layout_ = std::move(layout);
-      layout_->set_margin({7, 7});
-
-      message_handler_.on_message<WM_SETFONT>([this](HWND hwnd, const auto& params) {
-        layout_->set_font(hwnd, params.hfont());
-      });
-    }
-  }
-
-protected:
-  virtual void on_create(HWND hwnd, const create_params&) {
-    refresh_font(hwnd, GetDpiForWindow(hwnd));
-  }
-
-  virtual void on_dpi_changed(HWND hwnd, const dpichanged_params& params) {
-    refresh_font(hwnd, params.dpi_x());
-
-    auto suggested = params.suggested_rect();
-    SetWindowPos(
-        hwnd, nullptr,
-        suggested->left, suggested->top,
-        suggested->right - suggested->left,
-        suggested->bottom - suggested->top,
-        SWP_NOZORDER | SWP_NOACTIVATE);
-  }
-
-  virtual void on_size(HWND hwnd, [[maybe_unused]] const wndkit::size_params& params) {
-    if (layout_) {
-      RECT rect{};
-      GetClientRect(hwnd, &rect);
-      layout_->resize(rect);
-    }
-  }
-
-  virtual void on_close(HWND hwnd, [[maybe_unused]] const wndkit::close_params& params) {
-    DestroyWindow(hwnd);
-  }
-
-  virtual LRESULT on_ctl_color_static(HWND hwnd, const wndkit::ctlcolorstatic_params& params) {
-    SetBkMode(params.hdc(), TRANSPARENT);
-    return reinterpret_cast<LRESULT>(GetSysColorBrush(COLOR_WINDOW));
-  }
-
-  static wil::unique_hfont get_default_ui_font(UINT dpi) {
-    NONCLIENTMETRICSW ncm{};
-    ncm.cbSize = sizeof(ncm);
-
-    if (SystemParametersInfoForDpi(SPI_GETNONCLIENTMETRICS, sizeof(ncm), &ncm, 0, dpi))
-      return wil::unique_hfont(CreateFontIndirectW(&ncm.lfMessageFont));
-
-    // Fallback if that fails
-    LOGFONTW lf{};
-    GetObjectW(GetStockObject(DEFAULT_GUI_FONT), sizeof(lf), &lf);
-    lf.lfUnderline = TRUE;
-    return wil::unique_hfont(CreateFontIndirectW(&lf));
-  }
-
-  void refresh_font(HWND hwnd, UINT dpi) {
-    font_ = get_default_ui_font(dpi);
-    SendMessageW(hwnd, WM_SETFONT, reinterpret_cast<WPARAM>(font_.get()), TRUE);
-    EnumChildWindows(hwnd, [](HWND child, LPARAM font_param) -> BOOL {
-      SendMessageW(child, WM_SETFONT, font_param, TRUE);
-      return TRUE;
-    }, reinterpret_cast<LPARAM>(font_.get()));
-  }
-
-  wil::unique_hfont font_;
-  wndkit::message_handler message_handler_;
-  std::unique_ptr<wndkit::widgets::layout> layout_;
-};
-
-}
+#pragma once
+
+#include <windows.h>
+#include <shellscalingapi.h>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <wil/resource.h>
+#include <wndkit/dispatcher.hpp>
+#include <wndkit/message_filters.hpp>
+#include <wndkit/message_handler.hpp>
+#include "core/frame_pacer.hpp"
+#include "element.hpp"
+#include "font_metrics_cache.hpp"
+#include "gdi_cache.hpp"
+#include "layout.hpp"
+#include "text_measure_cache.hpp"
+
+namespace wndkit::widgets {
+
+class top_level_window {
+public:
+  top_level_window() {
+    message_handler_
+      .on_message<WM_CREATE>([this](HWND hwnd, const create_params& params) {
+        hwnd_ = hwnd;
+        if (elements_)
+          elements_->attach(hwnd);
+        on_create(hwnd, params);
+      })
+      .on_message<WM_DPICHANGED>([this](HWND hwnd, const auto& params) {
+        on_dpi_changed(hwnd, params);
+      })
+      .on_message<WM_SETTINGCHANGE>([this](HWND hwnd, const auto& params) {
+        on_setting_change(hwnd, params);
+      })
+      .on_message<WM_SIZE>([this](HWND hwnd, const auto& params) {
+        on_size(hwnd, params);
+      })
+      .on_message<WM_ENTERSIZEMOVE>([this](HWND hwnd, const auto&) {
+        on_enter_size_move(hwnd);
+      })
+      .on_message<WM_EXITSIZEMOVE>([this](HWND hwnd, const auto&) {
+        on_exit_size_move(hwnd);
+      })
+      .on_message<WM_TIMER>([this](HWND hwnd, const auto&) {
+        on_layout_timer(hwnd);
+      }, timer_filter{.id = layout_timer_id})
+      .on_message<WM_CLOSE>([this](HWND hwnd, const auto& params) {
+        on_close(hwnd, params);
+      })
+      .on_message<WM_CTLCOLORSTATIC>([this](HWND hwnd, const auto& params) {
+        return on_ctl_color_static(hwnd, params);
+      })
+      .reflect_notifications()
+    ;
+  }
+
+  template<typename... Args>
+  auto create(Args&&... args) {
+    return wndkit::dispatcher::create_window(&message_handler_, std::forward<Args>(args)...);
+  }
+
+  // how the layout follows the window's size while the user drags its border
+  enum class resize_mode {
+    immediate,  // on every WM_SIZE
+    frame_paced // at most once per display frame, with an exact pass when the drag ends
+  };
+
+  layout& layout() { return *layout_.get(); }
+
+  // the windowless elements painted in this window
+  element_host& elements() {
+    if (!elements_) {
+      elements_ = std::make_unique<element_host>(message_handler_);
+      elements_->attach(hwnd_);
+      elements_->set_font(font_);
+    }
+
+    return *elements_;
+  }
+
+  void set_resize_mode(resize_mode mode) {
+    resize_mode_ = mode;
+  }
+
+  /*
+     Suspends redrawing and layout while the window's children are rebuilt.
+
+     When the last open scope closes, children created in the meantime are given the
+     window's font, the layout is measured and applied once (with a single
+     DeferWindowPos batch) and the window is invalidated once. Redraw is only suspended if
+     the window is visible when the first scope opens; a hidden window stays hidden.
+
+       {
+         auto update = window.update();
+         // create children and add them to window.layout()
+       }
+  */
+  class update_scope {
+  public:
+    explicit update_scope(top_level_window& window) :
+      window_(window) {
+      window_.begin_update();
+    }
+
+    update_scope(const update_scope&) = delete;
+    update_scope& operator=(const update_scope&) = delete;
+
+    ~update_scope() {
+      window_.end_update();
+    }
+
+  private:
+    top_level_window& window_;
+  };
+
+  [[nodiscard]] update_scope update() {
+    return update_scope(*this);
+  }
+
+  void set_layout(std::unique_ptr<wndkit::widgets::layout> layout) {
+    assert(!layout_);
+    if (!layout_) {
+      layout_ = std::move(layout);
+      layout_->set_margin({7, 7});
+      if (update_depth_ > 0)
+        layout_update_.emplace(*layout_);
+
+      message_handler_.on_message<WM_SETFONT>([this](HWND hwnd, const auto& params) {
+        layout_->set_font(hwnd, params.hfont());
+      });
+    }
+  }
+
+protected:
+  using frame_pacer = core::frame_pacer;
+
+  static constexpr UINT_PTR layout_timer_id = 0x776b; // "wk"
+
+  virtual void on_create(HWND hwnd, const create_params&) {
+    refresh_font(hwnd, GetDpiForWindow(hwnd));
+  }
+
+  virtual void on_dpi_changed(HWND hwnd, const dpichanged_params& params) {
+    font_metrics_cache::instance().clear();
+    text_measure_cache::instance().clear();
+    refresh_font(hwnd, params.dpi_x(), params.suggested_rect());
+  }
+
+  virtual void on_setting_change(HWND hwnd, const wndkit::settingchange_params& params) {
+    if (!affects_text_metrics(params.action()))
+      return;
+
+    // the fonts and texts were measured with the old settings
+    font_metrics_cache::instance().clear();
+    text_measure_cache::instance().clear();
+
+    if (params.action() == SPI_SETNONCLIENTMETRICS) {
+      // the children use the old fonts until they are given the new ones
+      decltype(fonts_) old_fonts;
+      old_fonts.swap(fonts_);
+      refresh_font(hwnd, GetDpiForWindow(hwnd));
+    }
+  }
+
+  virtual void on_size(HWND hwnd, [[maybe_unused]] const wndkit::size_params& params) {
+    // a font refresh lays out once when it is done
+    if (refreshing_font_)
+      return;
+
+    // during a paced drag the size is picked up by the timer when the frame is due
+    if (resize_pacer_.request(frame_pacer::clock::now()))
+      update_layout(hwnd);
+  }
+
+  virtual void on_enter_size_move(HWND hwnd) {
+    if (resize_mode_ != resize_mode::frame_paced)
+      return;
+
+    resize_pacer_.set_interval(frame_interval(hwnd));
+    resize_pacer_.begin();
+
+    // timers are still dispatched by the modal size/move loop
+    auto interval = std::chrono::ceil<std::chrono::milliseconds>(resize_pacer_.interval());
+    SetTimer(hwnd, layout_timer_id, static_cast<UINT>(interval.count()), nullptr);
+  }
+
+  virtual void on_exit_size_move(HWND hwnd) {
+    if (!resize_pacer_.active())
+      return;
+
+    KillTimer(hwnd, layout_timer_id);
+
+    // the final pass uses the exact size the drag ended with
+    if (resize_pacer_.end())
+      update_layout(hwnd);
+  }
+
+  void update_layout(HWND hwnd) {
+    if (layout_) {
+      RECT rect{};
+      GetClientRect(hwnd, &rect);
+      layout_->resize(rect);
+    }
+  }
+
+  virtual void on_close(HWND hwnd, [[maybe_unused]] const wndkit::close_params& params) {
+    DestroyWindow(hwnd);
+  }
+
+  virtual LRESULT on_ctl_color_static(HWND hwnd, const wndkit::ctlcolorstatic_params& params) {
+    SetBkMode(params.hdc(), TRANSPARENT);
+    return reinterpret_cast<LRESULT>(GetSysColorBrush(COLOR_WINDOW));
+  }
+
+  // windows at the same DPI share the font through the process-wide cache
+  static gdi_cache::font_handle get_default_ui_font(UINT dpi) {
+    NONCLIENTMETRICSW ncm{};
+    ncm.cbSize = sizeof(ncm);
+
+    if (SystemParametersInfoForDpi(SPI_GETNONCLIENTMETRICS, sizeof(ncm), &ncm, 0, dpi))
+      return gdi_cache::instance().font(ncm.lfMessageFont, dpi);
+
+    // Fallback if that fails
+    LOGFONTW lf{};
+    GetObjectW(GetStockObject(DEFAULT_GUI_FONT), sizeof(lf), &lf);
+    lf.lfUnderline = TRUE;
+    return gdi_cache::instance().font(lf, dpi);
+  }
+
+  void begin_update() {
+    if (update_depth_++ > 0)
+      return;
+
+    // a hidden window (often the one being filled) draws nothing, and ending a suspension would show it
+    if (hwnd_ && IsWindowVisible(hwnd_))
+      suspension_.emplace(hwnd_);
+    if (layout_)
+      layout_update_.emplace(*layout_);
+  }
+
+  void end_update() {
+    if (--update_depth_ > 0)
+      return;
+
+    if (hwnd_ && font_) {
+      EnumChildWindows(hwnd_, [](HWND child, LPARAM font_param) -> BOOL {
+        if (SendMessageW(child, WM_GETFONT, 0, 0) != font_param)
+          SendMessageW(child, WM_SETFONT, font_param, FALSE);
+        return TRUE;
+      }, reinterpret_cast<LPARAM>(font_));
+    }
+
+    // the layout records the current size and resizes once when its scope closes
+    if (hwnd_)
+      update_layout(hwnd_);
+    layout_update_.reset();
+
+    if (suspension_) {
+      suspension_.reset();
+      RedrawWindow(hwnd_, nullptr, nullptr, RDW_ERASE | RDW_FRAME | RDW_INVALIDATE | RDW_ALLCHILDREN);
+    }
+  }
+
+  void on_layout_timer(HWND hwnd) {
+    if (resize_pacer_.tick(frame_pacer::clock::now()))
+      update_layout(hwnd);
+  }
+
+  // whether a WM_SETTINGCHANGE for the SPI_* `action` can change the size of fonts or text
+  static bool affects_text_metrics(UINT action) {
+    switch (action) {
+      case SPI_SETNONCLIENTMETRICS:
+      case SPI_SETICONTITLELOGFONT:
+      case SPI_SETICONMETRICS:
+      case SPI_SETFONTSMOOTHING:
+      case SPI_SETFONTSMOOTHINGTYPE:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  // the refresh interval of the monitor the window is on
+  static frame_pacer::duration frame_interval(HWND hwnd) {
+    MONITORINFOEXW info{};
+    info.cbSize = sizeof(info);
+    DEVMODEW mode{};
+    mode.dmSize = sizeof(mode);
+
+    if (!GetMonitorInfoW(MonitorFromWindow(hwnd, MONITOR_DEFAULTTONEAREST), &info) ||
+        !EnumDisplaySettingsW(info.szDevice, ENUM_CURRENT_SETTINGS, &mode) ||
+        mode.dmDisplayFrequency <= 1) // 0 and 1 mean the hardware default
+      return frame_pacer::default_interval;
+
+    return std::chrono::duration_cast<frame_pacer::duration>(std::chrono::seconds(1)) / mode.dmDisplayFrequency;
+  }
+
+  // gives the window and its children the default UI font for `dpi` (and moves the window to `window_rect`, if given)
+  // with redraw suspended, then lays out and repaints once
+  void refresh_font(HWND hwnd, UINT dpi, const RECT* window_rect = nullptr) {
+    auto& font = fonts_[dpi];
+    if (!font)
+      font = get_default_ui_font(dpi);
+    font_ = font.get();
+    if (elements_)
+      elements_->set_font(font_);
+
+    // an open update scope has already suspended redraw and repaints when it closes. A hidden
+    // window (such as during WM_CREATE) is not suspended: ending a suspension with WM_SETREDRAW
+    // makes the window visible, before the caller's ShowWindow
+    auto suspend = update_depth_ == 0 && IsWindowVisible(hwnd);
+    {
+      std::optional<redraw_suspension> suspension;
+      if (suspend)
+        suspension.emplace(hwnd);
+      refreshing_font_ = true;
+
+      // the children are repainted with the window below rather than one by one
+      SendMessageW(hwnd, WM_SETFONT, reinterpret_cast<WPARAM>(font.get()), FALSE);
+      EnumChildWindows(hwnd, [](HWND child, LPARAM font_param) -> BOOL {
+        SendMessageW(child, WM_SETFONT, font_param, FALSE);
+        return TRUE;
+      }, reinterpret_cast<LPARAM>(font.get()));
+
+      if (window_rect) {
+        SetWindowPos(
+            hwnd, nullptr,
+            window_rect->left, window_rect->top,
+            window_rect->right - window_rect->left,
+            window_rect->bottom - window_rect->top,
+            SWP_NOZORDER | SWP_NOACTIVATE);
+      }
+
+      refreshing_font_ = false;
+      update_layout(hwnd);
+    }
+
+    if (suspend)
+      RedrawWindow(hwnd, nullptr, nullptr, RDW_ERASE | RDW_FRAME | RDW_INVALIDATE | RDW_ALLCHILDREN);
+  }
+
+  // stops a window (and so its children) from being redrawn until destroyed; ending it makes
+  // the window visible, so it is only used for windows that already are
+  class redraw_suspension {
+  public:
+    explicit redraw_suspension(HWND hwnd) :
+      hwnd_(hwnd) {
+      SendMessageW(hwnd_, WM_SETREDRAW, FALSE, 0);
+    }
+
+    redraw_suspension(const redraw_suspension&) = delete;
+    redraw_suspension& operator=(const redraw_suspension&) = delete;
+
+    ~redraw_suspension() {
+      SendMessageW(hwnd_, WM_SETREDRAW, TRUE, 0);
+    }
+
+  private:
+    HWND hwnd_;
+  };
+
+  HWND hwnd_{};
+  std::unordered_map<UINT, gdi_cache::font_handle> fonts_; // the default UI font for each DPI the window has been shown at
+  HFONT font_{};                                          // the font the window's children were last given
+  bool refreshing_font_{};
+  resize_mode resize_mode_{resize_mode::immediate};
+  frame_pacer resize_pacer_;
+  int update_depth_{};
+  std::optional<redraw_suspension> suspension_;
+  std::optional<wndkit::widgets::layout::update_scope> layout_update_;
+  wndkit::message_handler message_handler_;
+  std::unique_ptr<wndkit::widgets::layout> layout_;
+  std::unique_ptr<element_host> elements_;
+};
+
+}
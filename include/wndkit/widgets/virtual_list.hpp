@@ -0,0 +1,364 @@
+#pragma once
+
+#include <windows.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <system_error>
+#include <vector>
+#include <wndkit/dispatcher.hpp>
+#include <wndkit/message_handler.hpp>
+#include "core/row_range.hpp"
+
+namespace wndkit::widgets {
+
+/*
+   A vertically scrolling list of rows that only creates windows for the rows it shows.
+
+   A list of many rows would otherwise need a window per row. Instead, a window is made
+   (with the `create_row` callback) for each visible row plus a few rows of overscan. As the
+   list scrolls, rows that leave the view go back to a pool and are reused for rows that
+   come into it; `bind_row` gives a row window the data of the row it now shows.
+
+   Scrolling moves the already painted rows with ScrollWindowEx, so only the newly exposed
+   rows are bound, positioned and painted.
+*/
+class virtual_list {
+public:
+  // creates a row window (a child of `parent`), or returns null if it cannot
+  using create_row_fn = std::function<HWND(HWND parent)>;
+
+  // shows the data of row `index` in a row window
+  using bind_row_fn = std::function<void(HWND row, size_t index)>;
+
+  virtual_list() = default;
+
+  virtual_list(const virtual_list&) = delete;
+  virtual_list& operator=(const virtual_list&) = delete;
+
+  static constexpr const wchar_t* class_name() {
+    return L"wndkit_virtual_list";
+  }
+
+  HWND create(HWND parent, int x, int y, int width, int height, HINSTANCE instance) {
+    message_handler_
+      .on_message<WM_SIZE>([this](HWND, const auto&) { on_size(); })
+      .on_message<WM_VSCROLL>([this](HWND, const auto& params) { on_vscroll(params); })
+      .on_message<WM_MOUSEWHEEL>([this](HWND, const auto& params) { on_mouse_wheel(params); })
+      .on_message<WM_SETFONT>([this](HWND, const auto& params) { on_set_font(params); })
+      .on_message<WM_GETFONT>([this](HWND, const auto&) { return reinterpret_cast<LRESULT>(font_); })
+    ;
+
+    hwnd_ = wndkit::dispatcher::create_window(&message_handler_,
+      0,
+      class_name(),
+      nullptr,
+      WS_CHILD | WS_VISIBLE | WS_VSCROLL | WS_CLIPCHILDREN,
+      x, y, width, height,
+      parent, nullptr,
+      instance, nullptr);
+    if (!hwnd_)
+      throw std::system_error(static_cast<int>(GetLastError()), std::system_category());
+
+    return hwnd_;
+  }
+
+  void set_row_callbacks(create_row_fn create_row, bind_row_fn bind_row) {
+    create_row_ = std::move(create_row);
+    bind_row_ = std::move(bind_row);
+  }
+
+  // the height of every row (in pixels)
+  void set_row_height(int32_t height) {
+    row_height_ = std::max(height, 1);
+    update(true);
+  }
+
+  // the number of rows to keep beyond each edge of the view, so small scrolls need no new rows
+  void set_overscan(size_t rows) {
+    overscan_ = rows;
+    update(false);
+  }
+
+  // changes the number of rows; every row shown is bound again
+  void set_row_count(size_t count) {
+    row_count_ = count;
+    update(true);
+  }
+
+  size_t row_count() const {
+    return row_count_;
+  }
+
+  // binds the shown rows again (for example after the data changed)
+  void refresh() {
+    update(true);
+  }
+
+  // scrolls so that row `index` is entirely visible
+  void scroll_to(size_t index) {
+    auto top = static_cast<int64_t>(index) * row_height_;
+    auto viewport = client_height();
+    if (top < offset_)
+      scroll_to_offset(top);
+    else if (top + row_height_ > offset_ + viewport)
+      scroll_to_offset(top + row_height_ - viewport);
+  }
+
+  // the windows of the rows in `shown_rows()`, in order; null for a row whose window could not be
+  // created (creating it is tried again when the rows are next realized)
+  const std::vector<HWND>& row_windows() const {
+    return rows_;
+  }
+
+  core::row_range shown_rows() const {
+    return range_;
+  }
+
+  static ATOM register_class(HINSTANCE instance) {
+    WNDCLASSW wc{};
+    wc.lpfnWndProc   = wndkit::dispatcher::window_proc;
+    wc.hCursor       = LoadCursorW(nullptr, reinterpret_cast<LPCWSTR>(IDC_ARROW));
+    wc.hbrBackground = reinterpret_cast<HBRUSH>(COLOR_WINDOW + 1);
+    wc.hInstance     = instance;
+    wc.lpszClassName = class_name();
+
+    auto atom = RegisterClassW(&wc);
+    if (!atom)
+      throw std::system_error(static_cast<int>(GetLastError()), std::system_category());
+
+    return atom;
+  }
+
+private:
+  int32_t client_height() const {
+    RECT rect{};
+    GetClientRect(hwnd_, &rect);
+    return rect.bottom - rect.top;
+  }
+
+  // clamps the offset, updates the scroll bar and realizes the rows; `rebind` binds every shown row again
+  void update(bool rebind) {
+    if (!hwnd_)
+      return;
+
+    offset_ = std::clamp<int64_t>(offset_, 0, core::max_scroll_offset(client_height(), row_height_, row_count_));
+    update_scroll_bar();
+    realize(true, rebind);
+  }
+
+  void update_scroll_bar() {
+    // the scroll bar positions are ints; longer lists are scaled into range
+    scale_ = std::max<int64_t>(static_cast<int64_t>(row_count_) * row_height_ / INT32_MAX + 1, 1);
+
+    SCROLLINFO si{};
+    si.cbSize = sizeof(si);
+    si.fMask  = SIF_RANGE | SIF_PAGE | SIF_POS;
+    si.nMin   = 0;
+    si.nMax   = static_cast<int>(std::max<int64_t>(static_cast<int64_t>(row_count_) * row_height_ / scale_ - 1, 0));
+    si.nPage  = static_cast<UINT>(client_height() / scale_);
+    si.nPos   = static_cast<int>(offset_ / scale_);
+    SetScrollInfo(hwnd_, SB_VERT, &si, TRUE);
+  }
+
+  void scroll_to_offset(int64_t offset) {
+    auto viewport = client_height();
+    offset = std::clamp<int64_t>(offset, 0, core::max_scroll_offset(viewport, row_height_, row_count_));
+    if (offset == offset_)
+      return;
+
+    auto delta = offset_ - offset;
+    offset_ = offset;
+    update_scroll_bar();
+
+    if (delta > -viewport && delta < viewport) {
+      // the rows still shown move with the pixels already painted; only the exposed strip is repainted
+      ScrollWindowEx(hwnd_, 0, static_cast<int>(delta), nullptr, nullptr, nullptr, nullptr, SW_SCROLLCHILDREN | SW_INVALIDATE | SW_ERASE);
+      realize(false, false);
+    } else {
+      realize(true, false);
+      InvalidateRect(hwnd_, nullptr, TRUE);
+    }
+  }
+
+  /*
+     Makes the row windows match the rows in view.
+
+     Rows leaving the view are hidden and pooled; rows coming into view take a pooled window
+     (or a new one), are bound and are positioned. Rows that stay in view are left where the
+     scroll put them unless `reposition` is true (after a resize, or a jump larger than the view).
+  */
+  void realize(bool reposition, bool rebind) {
+    RECT client{};
+    GetClientRect(hwnd_, &client);
+    auto range = core::visible_rows(offset_, client.bottom, row_height_, row_count_, overscan_);
+
+    std::vector<HWND> rows(range.size());
+    std::vector<HWND> released;
+    for (auto index = range_.first; index < range_.last; ++index) {
+      auto row = rows_[index - range_.first];
+      if (range.contains(index))
+        rows[index - range.first] = row;
+      else if (row)
+        released.push_back(row); // a row without a window has nothing to pool
+    }
+
+    std::vector<row_move> moves;
+    auto move = [&moves](HWND row, int y, int cx, int cy, UINT flags) {
+      moves.push_back({row, y, cx, cy, flags | SWP_NOZORDER | SWP_NOACTIVATE});
+    };
+
+    for (auto row : released) {
+      move(row, 0, 0, 0, SWP_HIDEWINDOW | SWP_NOMOVE | SWP_NOSIZE);
+      pool_.push_back(row);
+    }
+
+    for (auto index = range.first; index < range.last; ++index) {
+      auto& row = rows[index - range.first];
+      auto fresh = !row;
+      if (fresh)
+        row = acquire();
+      if (!row)
+        continue;
+
+      if (fresh || rebind)
+        bind_row_(row, index);
+
+      if (fresh || reposition) {
+        auto top = static_cast<int>(static_cast<int64_t>(index) * row_height_ - offset_);
+        move(row, top, client.right, row_height_, SWP_SHOWWINDOW);
+      }
+    }
+
+    apply(moves);
+
+    rows_ = std::move(rows);
+    range_ = range;
+  }
+
+  struct row_move {
+    HWND row;
+    int y;
+    int cx;
+    int cy;
+    UINT flags;
+  };
+
+  // moves the rows in one DeferWindowPos batch, or one by one if the batch fails
+  static void apply(const std::vector<row_move>& moves) {
+    if (moves.empty())
+      return;
+
+    auto hdwp = BeginDeferWindowPos(static_cast<int>(moves.size()));
+    for (const auto& move : moves) {
+      if (hdwp)
+        hdwp = DeferWindowPos(hdwp, move.row, nullptr, 0, move.y, move.cx, move.cy, move.flags);
+    }
+
+    if (hdwp) {
+      EndDeferWindowPos(hdwp);
+      return;
+    }
+
+    for (const auto& move : moves)
+      SetWindowPos(move.row, nullptr, 0, move.y, move.cx, move.cy, move.flags);
+  }
+
+  // takes a row window from the pool, or creates one; null if `create_row` failed
+  HWND acquire() {
+    if (!pool_.empty()) {
+      auto row = pool_.back();
+      pool_.pop_back();
+      return row;
+    }
+
+    if (!create_row_)
+      return nullptr;
+
+    auto row = create_row_(hwnd_);
+    if (row && font_)
+      SendMessageW(row, WM_SETFONT, reinterpret_cast<WPARAM>(font_), FALSE);
+
+    return row;
+  }
+
+  void on_size() {
+    update(false);
+  }
+
+  void on_vscroll(const vscroll_params& params) {
+    auto viewport = client_height();
+    auto offset = offset_;
+
+    switch (params.scroll_request()) {
+      case SB_LINEUP:   offset -= row_height_; break;
+      case SB_LINEDOWN: offset += row_height_; break;
+      case SB_PAGEUP:   offset -= viewport; break;
+      case SB_PAGEDOWN: offset += viewport; break;
+      case SB_TOP:      offset = 0; break;
+      case SB_BOTTOM:   offset = core::max_scroll_offset(viewport, row_height_, row_count_); break;
+
+      case SB_THUMBTRACK:
+      case SB_THUMBPOSITION: {
+        // the 16-bit position in the message is not enough for long lists
+        SCROLLINFO si{};
+        si.cbSize = sizeof(si);
+        si.fMask  = SIF_TRACKPOS;
+        GetScrollInfo(hwnd_, SB_VERT, &si);
+        offset = int64_t{si.nTrackPos} * scale_;
+        break;
+      }
+
+      default:
+        return;
+    }
+
+    scroll_to_offset(offset);
+  }
+
+  void on_mouse_wheel(const mousewheel_params& params) {
+    UINT lines = 3;
+    SystemParametersInfoW(SPI_GETWHEELSCROLLLINES, 0, &lines, 0);
+
+    int64_t distance = lines == WHEEL_PAGESCROLL ? client_height() : int64_t{lines} * row_height_;
+
+    // high resolution wheels send a fraction of WHEEL_DELTA at a time
+    wheel_remainder_ += params.wheel_delta() * distance;
+    auto pixels = wheel_remainder_ / WHEEL_DELTA;
+    wheel_remainder_ -= pixels * WHEEL_DELTA;
+    auto offset = offset_ - pixels;
+
+    scroll_to_offset(offset);
+  }
+
+  void on_set_font(const setfont_params& params) {
+    font_ = params.hfont();
+
+    for (auto row : rows_) {
+      if (row)
+        SendMessageW(row, WM_SETFONT, reinterpret_cast<WPARAM>(font_), params.should_redraw());
+    }
+    for (auto row : pool_)
+      SendMessageW(row, WM_SETFONT, reinterpret_cast<WPARAM>(font_), FALSE);
+  }
+
+  wndkit::message_handler message_handler_;
+
+  HWND hwnd_{};
+  HFONT font_{};
+  create_row_fn create_row_;
+  bind_row_fn bind_row_;
+
+  int32_t row_height_{20};
+  size_t overscan_{4};
+  size_t row_count_{};
+  int64_t offset_{};           // the scroll position (in pixels)
+  int64_t scale_{1};           // pixels per scroll bar unit
+  int64_t wheel_remainder_{};  // wheel movement not yet scrolled (in pixels times WHEEL_DELTA)
+
+  core::row_range range_;      // the rows in `rows_`
+  std::vector<HWND> rows_;     // the windows of the rows in `range_`
+  std::vector<HWND> pool_;     // hidden windows ready to be reused
+};
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace wndkit::tests {
+
+/*
+   A minimal test harness.
+
+   `TEST(name)` defines a test that `run_tests` runs; `CHECK(condition)` reports a failed
+   condition and lets the test carry on, so one run shows every failure.
+*/
+struct test_case {
+  const char* name;
+  void (*run)();
+};
+
+inline std::vector<test_case>& test_cases() {
+  static std::vector<test_case> cases;
+  return cases;
+}
+
+inline int& failure_count() {
+  static int count = 0;
+  return count;
+}
+
+struct test_registrar {
+  test_registrar(const char* name, void (*run)()) {
+    test_cases().push_back({name, run});
+  }
+};
+
+inline void check_failed(const char* condition, const char* file, int line) {
+  ++failure_count();
+  std::printf("%s:%d: check failed: %s\n", file, line, condition);
+}
+
+// runs every test; returns the process exit code
+inline int run_tests() {
+  for (const auto& test : test_cases()) {
+    auto failures = failure_count();
+    test.run();
+    std::printf("%s %s\n", failure_count() == failures ? "passed" : "FAILED", test.name);
+  }
+
+  return failure_count() == 0 ? 0 : 1;
+}
+
+// the average time of `repeat` calls of `fn`, in microseconds
+template<typename Fn>
+double time_us(int repeat, Fn&& fn) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeat; ++i)
+    fn();
+  std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / repeat;
+}
+
+}
+
+#define TEST(name) \
+  static void name(); \
+  static ::wndkit::tests::test_registrar name##_registrar(#name, name); \
+  static void name()
+
+#define CHECK(condition) \
+  ((condition) ? void() : ::wndkit::tests::check_failed(#condition, __FILE__, __LINE__))
@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <wndkit/clipboard_writer.hpp>
+#include "check.hpp"
+
+using namespace wndkit::tests;
+
+namespace {
+
+constexpr size_t row_count = 100000;
+constexpr size_t column_count = 8;
+
+/*
+   Writes into heap memory, growing the same way as the clipboard's global memory block
+   (details::hglobal_writer): doubling from 4k, or to the reserved size.
+*/
+class memory_writer : public wndkit::clipboard_writer {
+public:
+  static constexpr size_t initial_capacity = 4096;
+
+  void reserve(size_t size) override {
+    if (size_ + size > capacity_)
+      grow(size_ + size);
+  }
+
+  void write(std::span<const std::byte> bytes) override {
+    if (size_ + bytes.size() > capacity_)
+      grow(std::max(capacity_ * 2, size_ + bytes.size()));
+
+    std::memcpy(data_.get() + size_, bytes.data(), bytes.size());
+    size_ += bytes.size();
+  }
+
+  std::span<const std::byte> bytes() const {
+    return {data_.get(), size_};
+  }
+
+  size_t grow_count{};
+
+private:
+  void grow(size_t capacity) {
+    capacity = std::max(capacity, initial_capacity);
+    auto data = std::make_unique_for_overwrite<std::byte[]>(capacity);
+    std::memcpy(data.get(), data_.get(), size_);
+    data_ = std::move(data);
+    capacity_ = capacity;
+    ++grow_count;
+  }
+
+  std::unique_ptr<std::byte[]> data_;
+  size_t size_{};
+  size_t capacity_{};
+};
+
+// a table to copy, as a grid control would hold it
+std::vector<std::wstring> make_cells() {
+  std::vector<std::wstring> cells;
+  cells.reserve(row_count * column_count);
+  for (size_t row = 0; row < row_count; ++row) {
+    for (size_t column = 0; column < column_count; ++column)
+      cells.push_back(L"cell " + std::to_wstring(row) + L":" + std::to_wstring(column));
+  }
+  return cells;
+}
+
+// renders the table as tab separated CF_UNICODETEXT, straight into the writer
+void render_tsv(const std::vector<std::wstring>& cells, wndkit::clipboard_writer& writer) {
+  for (size_t row = 0; row < row_count; ++row) {
+    for (size_t column = 0; column < column_count; ++column) {
+      writer.write_text(cells[row * column_count + column]);
+      writer.write_text(column + 1 < column_count ? std::wstring_view(L"\t") : std::wstring_view(L"\r\n"));
+    }
+  }
+  writer.write_null<wchar_t>();
+}
+
+// the same text built as a string first, then copied into the writer
+void render_tsv_buffered(const std::vector<std::wstring>& cells, wndkit::clipboard_writer& writer) {
+  std::wstring text;
+  for (size_t row = 0; row < row_count; ++row) {
+    for (size_t column = 0; column < column_count; ++column) {
+      text += cells[row * column_count + column];
+      text += column + 1 < column_count ? L"\t" : L"\r\n";
+    }
+  }
+  writer.write_text(text);
+  writer.write_null<wchar_t>();
+}
+
+}
+
+// serializes a 100k row table with the writer growing as it goes, with a size hint, and through an intermediate string
+TEST(serialize_table) {
+  auto cells = make_cells();
+
+  memory_writer streamed;
+  auto streamed_us = time_us(1, [&] { render_tsv(cells, streamed); });
+
+  size_t hint = 0;
+  for (const auto& cell : cells)
+    hint += (cell.size() + 2) * sizeof(wchar_t);
+
+  memory_writer reserved;
+  auto reserved_us = time_us(1, [&] {
+    reserved.reserve(hint);
+    render_tsv(cells, reserved);
+  });
+
+  memory_writer buffered;
+  auto buffered_us = time_us(1, [&] { render_tsv_buffered(cells, buffered); });
+
+  CHECK(std::ranges::equal(streamed.bytes(), reserved.bytes()));
+  CHECK(std::ranges::equal(streamed.bytes(), buffered.bytes()));
+
+  // the block doubles, so growing takes a handful of copies rather than one per write
+  CHECK(streamed.grow_count < 20);
+  CHECK(reserved.grow_count == 1);
+
+  std::printf("serialize %zu rows (%zu KB): streamed %.0f us (%zu grows), reserved %.0f us, buffered %.0f us\n",
+    row_count, streamed.bytes().size() / 1024, streamed_us, streamed.grow_count, reserved_us, buffered_us);
+}
+
+int main() {
+  return run_tests();
+}
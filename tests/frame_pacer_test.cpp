@@ -0,0 +1,159 @@
+#include <chrono>
+#include <wndkit/widgets/core/frame_pacer.hpp>
+#include "check.hpp"
+
+using namespace wndkit::tests;
+using namespace std::chrono_literals;
+using wndkit::widgets::core::frame_pacer;
+
+namespace {
+
+// a clock the test moves by hand
+struct fake_clock {
+  frame_pacer::time_point now{std::chrono::seconds(100)};
+
+  void advance(frame_pacer::duration by) {
+    now += by;
+  }
+};
+
+// drives a pacer the way top_level_window does during a drag, counting the layout passes
+struct paced_window {
+  explicit paced_window(fake_clock& clock) :
+    clock(clock) {
+  }
+
+  void enter_size_move() {
+    pacer.begin();
+  }
+
+  void size() {
+    if (pacer.request(clock.now))
+      ++layouts;
+  }
+
+  void timer() {
+    if (pacer.tick(clock.now))
+      ++layouts;
+  }
+
+  void exit_size_move() {
+    if (pacer.end())
+      ++layouts;
+  }
+
+  fake_clock& clock;
+  frame_pacer pacer{16ms};
+  int layouts{};
+};
+
+}
+
+TEST(requests_run_immediately_outside_a_drag) {
+  fake_clock clock;
+  paced_window window(clock);
+
+  for (int i = 0; i < 5; ++i)
+    window.size();
+  CHECK(window.layouts == 5);
+  CHECK(!window.pacer.pending());
+}
+
+TEST(requests_within_one_interval_are_coalesced) {
+  fake_clock clock;
+  paced_window window(clock);
+  window.enter_size_move();
+
+  // the first request of a drag runs, the rest of the frame only leaves one pending pass
+  window.size();
+  CHECK(window.layouts == 1);
+  for (int i = 0; i < 10; ++i) {
+    clock.advance(1ms);
+    window.size();
+    window.timer();
+  }
+  CHECK(window.layouts == 1);
+  CHECK(window.pacer.pending());
+}
+
+TEST(a_pending_request_runs_once_the_interval_elapses) {
+  fake_clock clock;
+  paced_window window(clock);
+  window.enter_size_move();
+  window.size();
+  auto started = clock.now;
+
+  clock.advance(5ms);
+  window.size();
+  CHECK(window.pacer.due() == started + 16ms);
+
+  clock.advance(10ms);
+  window.timer();
+  CHECK(window.layouts == 1);
+
+  clock.advance(1ms);
+  window.timer();
+  CHECK(window.layouts == 2);
+  CHECK(!window.pacer.pending());
+
+  // nothing more was requested, so later ticks do nothing
+  clock.advance(40ms);
+  window.timer();
+  CHECK(window.layouts == 2);
+
+  // and a request after a quiet interval runs straight away
+  window.size();
+  CHECK(window.layouts == 3);
+}
+
+TEST(one_pass_per_frame_during_a_long_drag) {
+  fake_clock clock;
+  paced_window window(clock);
+  window.enter_size_move();
+
+  // a WM_SIZE every 2ms and a timer every 4ms for one second
+  for (int ms = 0; ms < 1000; ++ms) {
+    if (ms % 2 == 0)
+      window.size();
+    if (ms % 4 == 0)
+      window.timer();
+    clock.advance(1ms);
+  }
+
+  CHECK(window.layouts >= 1000 / 20);
+  CHECK(window.layouts <= 1000 / 16 + 1);
+}
+
+TEST(exit_size_move_flushes_with_a_final_pass) {
+  fake_clock clock;
+  paced_window window(clock);
+  window.enter_size_move();
+  window.size();
+  clock.advance(2ms);
+  window.size();
+  CHECK(window.layouts == 1);
+
+  // the pending request is not left for a timer that no longer runs
+  window.exit_size_move();
+  CHECK(window.layouts == 2);
+  CHECK(!window.pacer.active() && !window.pacer.pending());
+
+  window.size();
+  CHECK(window.layouts == 3);
+}
+
+TEST(exit_size_move_without_a_resize_does_nothing) {
+  fake_clock clock;
+  paced_window window(clock);
+
+  // a window that was only moved
+  window.enter_size_move();
+  clock.advance(200ms);
+  window.timer();
+  window.exit_size_move();
+  CHECK(window.layouts == 0);
+}
+
+int main() {
+  return run_tests();
+}
@@ -0,0 +1,131 @@
+#include <cstdio>
+#include <vector>
+#include <wndkit/widgets/core/box_layout.hpp>
+#include <wndkit/widgets/core/layout.hpp>
+#include "check.hpp"
+#include "layout_support.hpp"
+
+using namespace wndkit::tests;
+
+namespace {
+
+constexpr size_t item_count = 10000;
+
+}
+
+// measures a 10k item tree from scratch, then through the cached measurements
+TEST(measure_cached) {
+  std::vector<layout_tree> trees;
+  for (int i = 0; i < 20; ++i)
+    trees.push_back(make_layout_tree(42, item_count));
+
+  size_t next = 0;
+  auto cold_us = time_us(20, [&] { trees[next++].root->calc_size(); });
+  auto cached_us = time_us(1000, [&] { trees.front().root->calc_size(); });
+
+  CHECK(trees.front().root->calc_size() == trees.back().root->calc_size());
+  std::printf("measure %zu items: %.1f us, cached %.3f us\n", item_count, cold_us, cached_us);
+}
+
+// places a 10k item tree, then resizes it with nothing changed and with one item changed
+TEST(resize_skips_unchanged_items) {
+  auto tree = make_layout_tree(42, item_count);
+  recording_sink sink;
+
+  auto first_us = time_us(1, [&] { tree.root->resize({0, 0, 1600, 1200}, sink); });
+  CHECK(sink.count == item_count);
+
+  core::layout::resize_result unchanged;
+  auto unchanged_us = time_us(50, [&] { unchanged = tree.root->resize({0, 0, 1600, 1200}, sink); });
+  CHECK(unchanged.moved == 0);
+  CHECK(unchanged.skipped == item_count);
+
+  // only the items whose rectangle the change affects are placed again
+  int32_t width = 10;
+  core::layout::resize_result changed;
+  auto changed_us = time_us(50, [&] {
+    tree.root->set_widget_size(tree.items.back(), {width++ % 60, 10});
+    changed = tree.root->resize({0, 0, 1600, 1200}, sink);
+  });
+  CHECK(changed.moved + changed.skipped == item_count);
+  CHECK(changed.moved < item_count);
+
+  std::printf("resize %zu items: first %.1f us, unchanged %.1f us, one item changed %.1f us (%zu moved)\n",
+    item_count, first_us, unchanged_us, changed_us, changed.moved);
+}
+
+// arranges the same tree with each engine; every pass moves every item, so nothing is skipped
+TEST(flat_and_tree_engine_resize) {
+  auto tree = make_layout_tree(42, item_count, core::layout::engine::tree);
+  auto flat = make_layout_tree(42, item_count, core::layout::engine::flat);
+  recording_sink tree_sink;
+  recording_sink flat_sink;
+
+  int32_t offset = 0;
+  auto tree_us = time_us(50, [&] { tree.root->resize({offset, 0, offset + 1600, 1200}, tree_sink); ++offset; });
+
+  offset = 0;
+  auto flat_us = time_us(50, [&] { flat.root->resize({offset, 0, offset + 1600, 1200}, flat_sink); ++offset; });
+
+  CHECK(tree_sink.placed == flat_sink.placed);
+  CHECK(tree_sink.count == flat_sink.count);
+  std::printf("resize %zu items: tree %.1f us, flat %.1f us\n", item_count, tree_us, flat_us);
+}
+
+// measures after an item changed size: the tree engine measures the boxes holding it, the flat engine recompiles
+TEST(flat_and_tree_engine_remeasure) {
+  auto tree = make_layout_tree(42, item_count, core::layout::engine::tree);
+  auto flat = make_layout_tree(42, item_count, core::layout::engine::flat);
+  recording_sink tree_sink;
+  recording_sink flat_sink;
+  tree.root->resize({0, 0, 1600, 1200}, tree_sink);
+  flat.root->resize({0, 0, 1600, 1200}, flat_sink);
+
+  int32_t width = 10;
+  auto tree_us = time_us(50, [&] {
+    tree.root->set_widget_size(tree.items[item_count / 2], {width++ % 60, 10});
+    tree.root->resize({0, 0, 1600, 1200}, tree_sink);
+  });
+
+  width = 10;
+  auto flat_us = time_us(50, [&] {
+    flat.root->set_widget_size(flat.items[item_count / 2], {width++ % 60, 10});
+    flat.root->resize({0, 0, 1600, 1200}, flat_sink);
+  });
+
+  CHECK(tree_sink.placed == flat_sink.placed);
+  std::printf("remeasure and resize %zu items: tree %.1f us, flat %.1f us\n", item_count, tree_us, flat_us);
+}
+
+// shares the space of a 5k item box between stretched items with limits, at a different width on every pass
+TEST(box_distributes_stretched_items) {
+  constexpr size_t box_item_count = 5000;
+  core::box_layout box(core::box_layout::orientation::horizontal);
+  for (core::item_handle item = 1; item <= box_item_count; ++item) {
+    core::layout::item_options options;
+    options.stretch = static_cast<int32_t>(item % 4);
+    if (item % 3 == 0)
+      options.max_dlu = {static_cast<int32_t>(20 + item % 40), core::unbounded};
+    if (item % 5 == 0)
+      options.min_dlu = {static_cast<int32_t>(item % 10), 0};
+
+    box.add_widget(item, core::alignment_flag::none, core::size{static_cast<int32_t>(10 + item % 30), 10}, options);
+  }
+  box.set_font_size(default_font_size);
+
+  recording_sink sink;
+  box.resize({0, 0, 60000, 200}, sink);
+
+  int32_t width = 40000;
+  core::layout::resize_result result;
+  auto resize_us = time_us(200, [&] { result = box.resize({0, 0, width, 200}, sink); width += 300; });
+
+  // the stretched items fill the box exactly
+  CHECK(result.moved > 0);
+  CHECK(sink.placed[box_item_count].right == width - 300);
+  std::printf("distribute %zu box items: %.1f us\n", box_item_count, resize_us);
+}
+
+int main() {
+  return run_tests();
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+#include <wndkit/widgets/core/box_layout.hpp>
+#include <wndkit/widgets/core/layout.hpp>
+
+namespace wndkit::tests {
+
+namespace core = wndkit::widgets::core;
+
+// stands in for the windows a layout moves: remembers where each item was placed
+class recording_sink : public core::placement_sink {
+public:
+  void place(core::item_handle item, const core::rect& area) override {
+    if (item >= placed.size())
+      placed.resize(item + 1);
+
+    placed[item] = area;
+    ++count;
+  }
+
+  std::vector<core::rect> placed; // indexed by item handle
+  size_t count{};
+};
+
+// a layout tree, with its nested layouts kept so they can be changed after the tree is built
+struct layout_tree {
+  std::unique_ptr<core::box_layout> root;
+  std::vector<core::box_layout*> boxes; // the root first
+  std::vector<core::item_handle> items;
+};
+
+inline constexpr core::size default_font_size{7, 16};
+
+/*
+   A tree of nested horizontal and vertical boxes holding `item_count` items, with sizes,
+   alignments, margins and spacings chosen from `seed`; trees built from the same seed are
+   identical. Items have no stretch or size limits, so the flat engine can compile the tree.
+*/
+inline layout_tree make_layout_tree(uint32_t seed, size_t item_count, core::layout::engine engine = core::layout::engine::tree) {
+  std::mt19937 random(seed);
+  auto pick = [&](int32_t low, int32_t high) { return std::uniform_int_distribution<int32_t>(low, high)(random); };
+
+  static constexpr core::alignment_flag alignments[] = {
+    core::alignment_flag::none,
+    core::alignment_flag::align_right,
+    core::alignment_flag::align_hcenter,
+    core::alignment_flag::align_bottom,
+    core::alignment_flag::align_vcenter,
+    core::alignment_flag::align_center,
+  };
+  auto alignment = [&] { return alignments[pick(0, std::size(alignments) - 1)]; };
+
+  layout_tree tree;
+  tree.root = std::make_unique<core::box_layout>(core::box_layout::orientation::vertical);
+  tree.root->set_margin({pick(0, 7), pick(0, 7)});
+  tree.boxes.push_back(tree.root.get());
+
+  core::item_handle next_item = 1;
+  while (tree.items.size() < item_count) {
+    auto parent = tree.boxes[pick(0, static_cast<int32_t>(tree.boxes.size()) - 1)];
+
+    // one box for every eight items or so keeps the tree a few levels deep
+    if (pick(0, 7) == 0) {
+      auto box = std::make_unique<core::box_layout>(pick(0, 1) ? core::box_layout::orientation::horizontal : core::box_layout::orientation::vertical);
+      box->set_margin({pick(0, 4), pick(0, 4)});
+      tree.boxes.push_back(box.get());
+      parent->add_layout(std::move(box), alignment());
+    } else {
+      parent->add_widget(next_item, alignment(), {pick(10, 60), pick(8, 14)});
+      tree.items.push_back(next_item++);
+    }
+  }
+
+  tree.root->set_font_size(default_font_size);
+  tree.root->set_engine(engine);
+  return tree;
+}
+
+}
@@ -0,0 +1,443 @@
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <wndkit/widgets/core/box_layout.hpp>
+#include <wndkit/widgets/core/grid_layout.hpp>
+#include <wndkit/widgets/core/layout.hpp>
+#include "check.hpp"
+#include "layout_support.hpp"
+
+using namespace wndkit::tests;
+
+namespace {
+
+// the same tree, arranged by each engine
+struct engine_pair {
+  explicit engine_pair(uint32_t seed, size_t item_count = 200) :
+    tree(make_layout_tree(seed, item_count, core::layout::engine::tree)),
+    flat(make_layout_tree(seed, item_count, core::layout::engine::flat)) {
+  }
+
+  void resize(const core::rect& area) {
+    tree.root->resize(area, tree_sink);
+    flat.root->resize(area, flat_sink);
+  }
+
+  bool same_placements() const {
+    return tree_sink.placed == flat_sink.placed && tree.root->calc_size() == flat.root->calc_size();
+  }
+
+  layout_tree tree;
+  layout_tree flat;
+  recording_sink tree_sink;
+  recording_sink flat_sink;
+};
+
+// a leaf sized in pixels and converted to dialog units with the layout's font, like an element sized to its text
+class pixel_sized_layout : public core::layout {
+public:
+  pixel_sized_layout(core::item_handle item, core::size size_px) :
+    item_(item),
+    size_px_(size_px) {
+  }
+
+  void set_size_px(core::size size_px) {
+    size_px_ = size_px;
+    invalidate();
+  }
+
+protected:
+  core::size measure() const override {
+    auto font = font_size();
+    if (font.cx <= 0 || font.cy <= 0)
+      return {};
+
+    return {(size_px_.cx * 4 + font.cx - 1) / font.cx, (size_px_.cy * 8 + font.cy - 1) / font.cy};
+  }
+
+  void arrange(placement& placement, const core::rect& area) override {
+    placement.move(item_, area);
+  }
+
+  bool measured_in_pixels() const override {
+    return true;
+  }
+
+private:
+  core::item_handle item_;
+  core::size size_px_;
+};
+
+// adds a pixel sized item to the same box of both trees
+std::pair<pixel_sized_layout*, pixel_sized_layout*> add_pixel_sized(engine_pair& engines, size_t box, core::item_handle item) {
+  auto tree_item = std::make_unique<pixel_sized_layout>(item, core::size{50, 20});
+  auto flat_item = std::make_unique<pixel_sized_layout>(item, core::size{50, 20});
+  std::pair result{tree_item.get(), flat_item.get()};
+
+  engines.tree.boxes[box]->add_layout(std::move(tree_item));
+  engines.flat.boxes[box]->add_layout(std::move(flat_item));
+  engines.tree.boxes[box]->add_widget(item + 1, core::alignment_flag::none, core::size{20, 10});
+  engines.flat.boxes[box]->add_widget(item + 1, core::alignment_flag::none, core::size{20, 10});
+  return result;
+}
+
+// a horizontal box measured with a font that makes a dialog unit one pixel across, with 4 pixel spacing and no margin
+std::unique_ptr<core::box_layout> make_pixel_box() {
+  auto box = std::make_unique<core::box_layout>(core::box_layout::orientation::horizontal);
+  box->set_font_size({4, 8});
+  return box;
+}
+
+// a grid measured with a font that makes a dialog unit one pixel across, with 4 pixel spacing and no margin
+std::unique_ptr<core::grid_layout> make_pixel_grid(std::vector<core::grid_track> columns, std::vector<core::grid_track> rows = {}) {
+  auto grid = std::make_unique<core::grid_layout>(std::move(columns), std::move(rows));
+  grid->set_font_size({4, 8});
+  return grid;
+}
+
+}
+
+TEST(flat_and_tree_engines_place_items_alike) {
+  for (uint32_t seed = 1; seed <= 20; ++seed) {
+    engine_pair engines(seed);
+    engines.resize({0, 0, 800, 600});
+    CHECK(engines.same_placements());
+    CHECK(engines.tree_sink.count == engines.tree.items.size());
+
+    // a larger area moves the aligned items
+    engines.resize({10, 20, 1210, 920});
+    CHECK(engines.same_placements());
+  }
+}
+
+TEST(flat_and_tree_engines_skip_the_same_items) {
+  engine_pair engines(7);
+  engines.resize({0, 0, 800, 600});
+
+  recording_sink tree_sink;
+  recording_sink flat_sink;
+  auto tree_result = engines.tree.root->resize({0, 0, 800, 600}, tree_sink);
+  auto flat_result = engines.flat.root->resize({0, 0, 800, 600}, flat_sink);
+
+  CHECK(tree_result.moved == 0 && flat_result.moved == 0);
+  CHECK(tree_result.skipped == flat_result.skipped);
+}
+
+TEST(flat_engine_follows_a_changed_item_size) {
+  engine_pair engines(3);
+  engines.resize({0, 0, 800, 600});
+
+  for (auto item : {engines.tree.items.front(), engines.tree.items[engines.tree.items.size() / 2]}) {
+    engines.tree.root->set_widget_size(item, {90, 30});
+    engines.flat.root->set_widget_size(item, {90, 30});
+    engines.resize({0, 0, 800, 600});
+    CHECK(engines.same_placements());
+  }
+}
+
+TEST(flat_engine_follows_a_font_change) {
+  engine_pair engines(5);
+  engines.resize({0, 0, 800, 600});
+
+  engines.tree.root->set_font_size({9, 20});
+  engines.flat.root->set_font_size({9, 20});
+  engines.resize({0, 0, 800, 600});
+  CHECK(engines.same_placements());
+}
+
+TEST(flat_engine_follows_items_added_to_a_nested_layout) {
+  engine_pair engines(11);
+  engines.resize({0, 0, 800, 600});
+
+  core::item_handle added = 10000;
+  for (auto box : {engines.tree.boxes.size() - 1, size_t{1}}) {
+    engines.tree.boxes[box]->add_widget(added, core::alignment_flag::none, core::size{40, 40});
+    engines.flat.boxes[box]->add_widget(added, core::alignment_flag::none, core::size{40, 40});
+    ++added;
+    engines.resize({0, 0, 800, 600});
+    CHECK(engines.same_placements());
+  }
+}
+
+TEST(flat_engine_follows_a_nested_layout_measured_again) {
+  engine_pair engines(13);
+  auto [tree_item, flat_item] = add_pixel_sized(engines, engines.tree.boxes.size() / 2, 20000);
+  engines.resize({0, 0, 800, 600});
+  CHECK(engines.same_placements());
+
+  tree_item->set_size_px({140, 45});
+  flat_item->set_size_px({140, 45});
+  engines.resize({0, 0, 800, 600});
+  CHECK(engines.same_placements());
+}
+
+TEST(flat_engine_follows_a_font_change_of_a_pixel_sized_item) {
+  engine_pair engines(17);
+  add_pixel_sized(engines, 1, 20000);
+  engines.resize({0, 0, 800, 600});
+
+  engines.tree.root->set_font_size({11, 24});
+  engines.flat.root->set_font_size({11, 24});
+  engines.resize({0, 0, 800, 600});
+  CHECK(engines.same_placements());
+}
+
+TEST(flat_engine_follows_a_nested_grid_whose_tracks_changed) {
+  struct grid_tree {
+    core::box_layout root{core::box_layout::orientation::vertical};
+    core::grid_layout* grid{};
+    recording_sink sink;
+  };
+
+  auto make = [](core::layout::engine engine) {
+    auto tree = std::make_unique<grid_tree>();
+    auto grid = std::make_unique<core::grid_layout>(std::vector{core::grid_track::automatic(), core::grid_track::automatic()}, std::vector<core::grid_track>{});
+    for (core::item_handle item = 10; item < 16; ++item)
+      grid->add_widget(item, core::alignment_flag::none, core::size{20, 10});
+
+    tree->grid = grid.get();
+    tree->root.add_widget(1, core::alignment_flag::none, core::size{30, 10});
+    tree->root.add_layout(std::move(grid));
+    tree->root.add_widget(2, core::alignment_flag::none, core::size{30, 10});
+    tree->root.set_font_size(default_font_size);
+    tree->root.set_engine(engine);
+    return tree;
+  };
+
+  auto tree = make(core::layout::engine::tree);
+  auto flat = make(core::layout::engine::flat);
+  tree->root.resize({0, 0, 400, 600}, tree->sink);
+  flat->root.resize({0, 0, 400, 600}, flat->sink);
+  CHECK(tree->sink.placed == flat->sink.placed);
+
+  for (auto grid : {tree->grid, flat->grid}) {
+    grid->set_rows({core::grid_track::fixed(40), core::grid_track::fixed(40), core::grid_track::fixed(40)});
+    grid->set_columns({core::grid_track::fixed(60), core::grid_track::fixed(60)});
+  }
+  tree->root.resize({0, 0, 400, 600}, tree->sink);
+  flat->root.resize({0, 0, 400, 600}, flat->sink);
+  CHECK(tree->sink.placed == flat->sink.placed);
+  CHECK(flat->sink.placed[2].top > tree->sink.placed[10].top + 100);
+}
+
+TEST(box_shares_free_space_by_stretch) {
+  auto box = make_pixel_box();
+  box->add_widget(1, core::alignment_flag::none, core::size{50, 10}, {.stretch = 1});
+  box->add_widget(2, core::alignment_flag::none, core::size{50, 10}, {.stretch = 3});
+  box->add_widget(3, core::alignment_flag::none, core::size{50, 10});
+
+  recording_sink sink;
+  box->resize({0, 0, 400, 100}, sink);
+  const auto& placed = sink.placed;
+
+  // 242 free pixels, a quarter to the first item and three quarters to the second, with nothing lost to rounding
+  CHECK(placed[1].width() + placed[2].width() == 100 + 242);
+  CHECK(std::abs((placed[2].width() - 50) - 3 * (placed[1].width() - 50)) <= 3);
+  CHECK(placed[3].width() == 50);
+  CHECK(placed[3].left == placed[2].right + 4 && placed[3].right == 400);
+
+  // across the box's direction items keep their size hint
+  CHECK(placed[1].height() == 10 && placed[2].height() == 10);
+}
+
+TEST(box_gives_space_a_clamped_item_can_not_take_to_the_others) {
+  auto box = make_pixel_box();
+  box->add_widget(1, core::alignment_flag::none, core::size{50, 10}, {.stretch = 1, .max_dlu = {70, core::unbounded}});
+  box->add_widget(2, core::alignment_flag::none, core::size{50, 10}, {.stretch = 1});
+
+  recording_sink sink;
+  box->resize({0, 0, 400, 100}, sink);
+  CHECK(sink.placed[1].width() == 70);
+  CHECK(sink.placed[2].width() == 396 - 70);
+  CHECK(sink.placed[2].right == 400);
+}
+
+TEST(box_shrinks_stretched_items_down_to_their_minimum) {
+  auto box = make_pixel_box();
+  box->add_widget(1, core::alignment_flag::none, core::size{100, 10}, {.stretch = 1, .min_dlu = {80, 0}});
+  box->add_widget(2, core::alignment_flag::none, core::size{100, 10}, {.stretch = 1});
+  box->add_widget(3, core::alignment_flag::none, core::size{30, 10});
+
+  // 96 pixels too few: an even share would take the first item below its minimum, so the second gives up the rest
+  recording_sink sink;
+  box->resize({0, 0, 142, 100}, sink);
+  CHECK(sink.placed[1].width() == 80);
+  CHECK(sink.placed[2].width() == 24);
+  CHECK(sink.placed[3].width() == 30);
+
+  // growing sorts the items by their maximum instead, which neither has
+  box->resize({0, 0, 400, 100}, sink);
+  CHECK(sink.placed[1].width() + sink.placed[2].width() == 400 - 8 - 30);
+  CHECK(sink.placed[1].width() == sink.placed[2].width());
+}
+
+TEST(box_keeps_an_unstretched_item_within_its_limits) {
+  auto box = make_pixel_box();
+  box->add_widget(1, core::alignment_flag::none, core::size{50, 10}, {.min_dlu = {60, 20}});
+  box->add_widget(2, core::alignment_flag::none, core::size{50, 10}, {.max_dlu = {40, 5}});
+
+  recording_sink sink;
+  box->resize({0, 0, 400, 100}, sink);
+  CHECK(sink.placed[1].width() == 60 && sink.placed[1].height() == 20);
+  CHECK(sink.placed[2].width() == 40 && sink.placed[2].height() == 5);
+  CHECK((box->calc_size() == core::size{60 + 4 + 40, 20}));
+}
+
+TEST(box_spacers_take_fixed_or_stretched_space) {
+  auto fixed = make_pixel_box();
+  fixed->add_widget(1, core::alignment_flag::none, core::size{50, 10});
+  fixed->add_spacer({20, 0});
+  fixed->add_widget(2, core::alignment_flag::none, core::size{50, 10});
+
+  recording_sink sink;
+  fixed->resize({0, 0, 400, 100}, sink);
+  CHECK(sink.placed[2].left == 50 + 4 + 20 + 4);
+  CHECK(fixed->calc_size().cx == 50 + 4 + 20 + 4 + 50);
+
+  // a stretch pushes the items after it to the far end, and stretches share the space between them
+  auto stretched = make_pixel_box();
+  stretched->add_widget(1, core::alignment_flag::none, core::size{50, 10});
+  stretched->add_stretch();
+  stretched->add_widget(2, core::alignment_flag::none, core::size{50, 10});
+  stretched->add_stretch();
+  stretched->add_widget(3, core::alignment_flag::none, core::size{50, 10});
+
+  recording_sink stretched_sink;
+  stretched->resize({0, 0, 400, 100}, stretched_sink);
+  CHECK(stretched_sink.placed[1].left == 0);
+  CHECK(stretched_sink.placed[3].right == 400);
+  CHECK(stretched_sink.placed[2].left - stretched_sink.placed[1].right == stretched_sink.placed[3].left - stretched_sink.placed[2].right);
+}
+
+TEST(grid_sizes_fixed_automatic_and_star_tracks) {
+  auto grid = make_pixel_grid({core::grid_track::automatic(), core::grid_track::fixed(30), core::grid_track::star(1), core::grid_track::star(3)});
+  grid->add_widget(1, {0, 0}, core::alignment_flag::none, core::size{50, 10});
+  grid->add_widget(2, {0, 1}, core::alignment_flag::none, core::size{20, 10});
+  grid->add_widget(3, {0, 2}, core::alignment_flag::none, core::size{10, 10});
+  grid->add_widget(4, {1, 3}, core::alignment_flag::none, core::size{10, 20});
+
+  // star tracks are measured by their content
+  CHECK((grid->calc_size() == core::size{50 + 30 + 10 + 10 + 3 * 4, 10 + 20 + 4}));
+
+  // 308 pixels are left for the star tracks, shared one to three
+  recording_sink sink;
+  grid->resize({0, 0, 400, 300}, sink);
+  const auto& placed = sink.placed;
+  CHECK(placed[1].width() == 50);
+  CHECK(placed[2].width() == 30 && placed[2].left == 54);
+  CHECK(placed[3].width() == 77 && placed[3].left == 88);
+  CHECK(placed[4].width() == 231 && placed[4].right == 400);
+
+  // rows are sized automatically, and items without an alignment fill their cells
+  CHECK(placed[1].height() == 10 && placed[3].height() == 10);
+  CHECK(placed[4].top == 14 && placed[4].height() == 20);
+}
+
+TEST(grid_items_span_several_tracks) {
+  auto grid = make_pixel_grid({core::grid_track::automatic(), core::grid_track::automatic(), core::grid_track::fixed(40)});
+  grid->add_widget(1, {0, 0}, core::alignment_flag::none, core::size{20, 10});
+  grid->add_widget(2, {0, 1}, core::alignment_flag::none, core::size{30, 10});
+  grid->add_widget(3, {1, 0, 1, 3}, core::alignment_flag::none, core::size{150, 10});
+  grid->add_widget(4, {0, 2, 3, 1}, core::alignment_flag::none, core::size{40, 60});
+
+  recording_sink sink;
+  grid->resize({0, 0, 400, 300}, sink);
+  const auto& placed = sink.placed;
+
+  // the spanning item widens the last track it covers that is not fixed
+  CHECK(placed[3].left == 0 && placed[3].width() == 150);
+  CHECK(placed[2].width() == 150 - 20 - 40 - 2 * 4);
+  CHECK(placed[4].left == placed[2].right + 4 && placed[4].width() == 40);
+
+  // and likewise across rows, where the third row is only created by the span
+  CHECK(placed[4].top == 0 && placed[4].height() == 60);
+  CHECK(placed[3].top == 14 && placed[3].height() == 10);
+  CHECK((grid->calc_size() == core::size{150, 60}));
+}
+
+TEST(grid_recomputes_the_track_of_an_item_measured_again) {
+  auto make = [](core::size changed) {
+    auto grid = make_pixel_grid({core::grid_track::automatic(), core::grid_track::automatic(), core::grid_track::automatic()});
+    grid->add_widget(1, {0, 0}, core::alignment_flag::none, core::size{20, 10});
+    grid->add_widget(2, {0, 1}, core::alignment_flag::none, changed);
+    grid->add_widget(3, {0, 2}, core::alignment_flag::none, core::size{30, 10});
+    grid->add_widget(4, {1, 1}, core::alignment_flag::none, core::size{25, 15});
+    grid->add_widget(5, {2, 0, 1, 3}, core::alignment_flag::none, core::size{60, 10});
+    return grid;
+  };
+
+  auto grid = make({10, 10});
+  recording_sink sink;
+  grid->resize({0, 0, 400, 300}, sink);
+  CHECK(sink.placed[3].left == 20 + 4 + 25 + 4);
+
+  // the cached tracks must end up as if the grid had been built with the new size
+  for (auto changed : {core::size{80, 30}, core::size{10, 10}, core::size{40, 5}}) {
+    grid->set_widget_size(2, changed);
+    grid->resize({0, 0, 400, 300}, sink);
+
+    auto fresh = make(changed);
+    recording_sink fresh_sink;
+    fresh->resize({0, 0, 400, 300}, fresh_sink);
+    CHECK(sink.placed == fresh_sink.placed);
+    CHECK(grid->calc_size() == fresh->calc_size());
+  }
+  CHECK(sink.placed[3].left == 20 + 4 + 40 + 4);
+}
+
+TEST(removed_items_are_no_longer_placed) {
+  engine_pair engines(19);
+  engines.resize({0, 0, 800, 600});
+  auto count = engines.tree.root->widget_count();
+
+  // two items from different parts of the tree
+  for (auto item : {engines.tree.items.front(), engines.tree.items.back()}) {
+    CHECK(engines.tree.root->remove_widget(item));
+    CHECK(engines.flat.root->remove_widget(item));
+    CHECK(!engines.flat.root->remove_widget(item));
+
+    engines.tree_sink.placed.assign(engines.tree_sink.placed.size(), {});
+    engines.flat_sink.placed.assign(engines.flat_sink.placed.size(), {});
+    engines.tree.root->reset_placements();
+    engines.flat.root->reset_placements();
+    engines.resize({0, 0, 800, 600});
+    CHECK(engines.same_placements());
+    CHECK(engines.tree_sink.placed[item] == core::rect{});
+  }
+
+  CHECK(engines.tree.root->widget_count() == count - 2);
+  CHECK(engines.flat.root->widget_count() == count - 2);
+}
+
+TEST(grid_removes_the_cell_of_a_removed_item) {
+  auto make = [](bool with_removed) {
+    auto grid = make_pixel_grid({core::grid_track::automatic(), core::grid_track::automatic()});
+    grid->add_widget(1, {0, 0}, core::alignment_flag::none, core::size{20, 10});
+    if (with_removed)
+      grid->add_widget(2, {0, 1}, core::alignment_flag::none, core::size{90, 40});
+    grid->add_widget(3, {1, 0}, core::alignment_flag::none, core::size{30, 10});
+    grid->add_widget(4, {1, 1}, core::alignment_flag::none, core::size{25, 15});
+    return grid;
+  };
+
+  auto grid = make(true);
+  recording_sink sink;
+  grid->resize({0, 0, 400, 300}, sink);
+
+  CHECK(grid->remove_widget(2));
+  grid->reset_placements();
+  recording_sink removed_sink;
+  grid->resize({0, 0, 400, 300}, removed_sink);
+
+  auto fresh = make(false);
+  recording_sink fresh_sink;
+  fresh->resize({0, 0, 400, 300}, fresh_sink);
+  CHECK(removed_sink.placed == fresh_sink.placed);
+  CHECK(grid->calc_size() == fresh->calc_size());
+}
+
+int main() {
+  return run_tests();
+}
@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+#include <wndkit/details/payload_pool.hpp>
+#include "check.hpp"
+
+using namespace wndkit::tests;
+using wndkit::details::payload_pool;
+
+namespace {
+
+constexpr int producer_count = 4;
+constexpr int batches_per_producer = 2000;
+constexpr size_t batch_size = 64;
+
+// a block's contents, so a block handed out twice or freed early shows up as a corrupted pattern
+struct block {
+  void* p;
+  size_t size;
+  uint32_t tag;
+};
+
+uint32_t tag_of(int producer, int batch, size_t index) {
+  return (static_cast<uint32_t>(producer) << 24) ^ (static_cast<uint32_t>(batch) << 8) ^ static_cast<uint32_t>(index);
+}
+
+void fill(const block& b) {
+  std::memset(b.p, static_cast<int>(b.tag & 0xff), b.size);
+  std::memcpy(b.p, &b.tag, sizeof(b.tag));
+}
+
+bool intact(const block& b) {
+  uint32_t tag;
+  std::memcpy(&tag, b.p, sizeof(tag));
+  if (tag != b.tag)
+    return false;
+
+  auto bytes = static_cast<const unsigned char*>(b.p);
+  for (size_t i = sizeof(tag); i < b.size; ++i) {
+    if (bytes[i] != (b.tag & 0xff))
+      return false;
+  }
+  return true;
+}
+
+// batches of blocks handed from the producers to the consumers
+class batch_queue {
+public:
+  void push(std::vector<block> batch) {
+    {
+      std::lock_guard lock(mutex_);
+      batches_.push_back(std::move(batch));
+    }
+    changed_.notify_one();
+  }
+
+  // an empty batch once every producer finished and the queue is drained
+  std::vector<block> pop() {
+    std::unique_lock lock(mutex_);
+    changed_.wait(lock, [this] { return !batches_.empty() || finished_; });
+    if (batches_.empty())
+      return {};
+
+    auto batch = std::move(batches_.front());
+    batches_.pop_front();
+    return batch;
+  }
+
+  void finish() {
+    {
+      std::lock_guard lock(mutex_);
+      finished_ = true;
+    }
+    changed_.notify_all();
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  std::deque<std::vector<block>> batches_;
+  bool finished_{};
+};
+
+struct stress_result {
+  double seconds{};
+  size_t blocks{};
+  size_t corrupted{};
+};
+
+/*
+   Producers allocate blocks of assorted sizes (some too large for the pool) and hand most
+   of them to consumer threads, which check and free them: those frees take the lock-free
+   remote path, and the producers take the blocks back when their local lists run dry.
+   The rest are freed by the producer, on the local path.
+*/
+template<typename Allocate, typename Deallocate>
+stress_result stress(int consumer_count, Allocate allocate, Deallocate deallocate) {
+  batch_queue queue;
+  std::atomic<size_t> blocks{};
+  std::atomic<size_t> corrupted{};
+
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> consumers;
+  for (int c = 0; c < consumer_count; ++c) {
+    consumers.emplace_back([&] {
+      while (true) {
+        auto batch = queue.pop();
+        if (batch.empty())
+          break;
+
+        for (const auto& b : batch) {
+          corrupted += !intact(b);
+          deallocate(b.p);
+        }
+        blocks += batch.size();
+      }
+    });
+  }
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < producer_count; ++p) {
+    producers.emplace_back([&, p] {
+      for (int n = 0; n < batches_per_producer; ++n) {
+        std::vector<block> batch;
+        batch.reserve(batch_size);
+        for (size_t i = 0; i < batch_size; ++i) {
+          auto size = 8 + (i * 37 + n) % 600; // spans every size class and past the largest
+          block b{allocate(size), size, tag_of(p, n, i)};
+          fill(b);
+          batch.push_back(b);
+        }
+
+        // every fourth batch is freed here
+        if (n % 4 == 3) {
+          for (const auto& b : batch) {
+            corrupted += !intact(b);
+            deallocate(b.p);
+          }
+          blocks += batch.size();
+        } else {
+          queue.push(std::move(batch));
+        }
+      }
+    });
+  }
+
+  for (auto& producer : producers)
+    producer.join();
+  queue.finish();
+  for (auto& consumer : consumers)
+    consumer.join();
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return {elapsed.count(), blocks.load(), corrupted.load()};
+}
+
+void report(const char* name, int consumer_count, const stress_result& result) {
+  std::printf("%-14s %d producers, %d consumers: %zu blocks in %.1f ms (%.0f ns per block)\n",
+    name, producer_count, consumer_count, result.blocks, result.seconds * 1e3, result.seconds * 1e9 / result.blocks);
+}
+
+}
+
+TEST(freed_blocks_are_reused_on_the_same_thread) {
+  auto first = payload_pool::allocate(100);
+  payload_pool::deallocate(first);
+  auto second = payload_pool::allocate(100);
+  CHECK(second == first);
+  payload_pool::deallocate(second);
+}
+
+TEST(remotely_freed_blocks_go_back_to_their_pool) {
+  std::vector<void*> blocks;
+  for (size_t i = 0; i < payload_pool::blocks_per_slab; ++i)
+    blocks.push_back(payload_pool::allocate(32));
+
+  std::thread([&] {
+    for (auto p : blocks)
+      payload_pool::deallocate(p);
+  }).join();
+
+  // the local list is empty, so the next allocations come from the remote list
+  std::vector<void*> reused;
+  for (size_t i = 0; i < payload_pool::blocks_per_slab; ++i)
+    reused.push_back(payload_pool::allocate(32));
+
+  size_t found = 0;
+  for (auto p : reused) {
+    found += std::find(blocks.begin(), blocks.end(), p) != blocks.end();
+    payload_pool::deallocate(p);
+  }
+  CHECK(found == blocks.size());
+}
+
+TEST(cross_thread_allocate_and_free) {
+  for (auto consumer_count : {1, 4}) {
+    auto pool = stress(consumer_count, payload_pool::allocate, payload_pool::deallocate);
+    CHECK(pool.corrupted == 0);
+    CHECK(pool.blocks == size_t{producer_count} * batches_per_producer * batch_size);
+    report("payload_pool", consumer_count, pool);
+
+    auto heap = stress(consumer_count, [](size_t size) { return ::operator new(size); }, [](void* p) { ::operator delete(p); });
+    CHECK(heap.corrupted == 0);
+    report("operator new", consumer_count, heap);
+  }
+}
+
+// a block freed after the thread that allocated it exited keeps the pool alive until then
+TEST(blocks_outlive_their_thread) {
+  std::vector<block> blocks;
+  std::thread([&] {
+    for (size_t i = 0; i < 10; ++i) {
+      block b{payload_pool::allocate(48), 48, tag_of(0, 0, i)};
+      fill(b);
+      blocks.push_back(b);
+    }
+  }).join();
+
+  for (const auto& b : blocks) {
+    CHECK(intact(b));
+    payload_pool::deallocate(b.p);
+  }
+}
+
+int main() {
+  return run_tests();
+}
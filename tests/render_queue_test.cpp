@@ -0,0 +1,187 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <wndkit/widgets/core/render_queue.hpp>
+#include "check.hpp"
+
+using namespace wndkit::tests;
+using wndkit::widgets::core::render_queue;
+
+namespace {
+
+struct request {
+  int32_t width{};
+};
+
+using queue_type = render_queue<request>;
+
+}
+
+TEST(requests_made_while_busy_are_coalesced) {
+  queue_type queue;
+  queue.request({1});
+  queue.request({2});
+  queue.request({3});
+
+  auto job = queue.wait();
+  CHECK(job && job->request.width == 3);
+  CHECK(job->generation == 3);
+  CHECK(queue.stats().requests == 3);
+  CHECK(queue.stats().coalesced == 2);
+}
+
+TEST(a_completed_frame_is_presented_and_kept) {
+  queue_type queue;
+  CHECK(!queue.present());
+
+  queue.request({10});
+  auto job = queue.wait();
+  CHECK(queue.complete(*job));
+
+  auto frame = queue.present();
+  CHECK(frame && frame->request.width == 10 && frame->buffer == job->buffer);
+
+  // with no newer frame, the same one is shown again
+  auto again = queue.present();
+  CHECK(again && again->generation == frame->generation);
+}
+
+TEST(a_frame_older_than_the_ready_frame_is_dropped) {
+  queue_type queue;
+  queue.request({1});
+  auto older = queue.wait();
+  queue.request({2});
+
+  // a second worker would render the newer request at the same time; simulated by taking it too
+  auto newer = queue.wait();
+  CHECK(older->buffer != newer->buffer);
+  CHECK(queue.complete(*newer));
+  CHECK(!queue.complete(*older));
+
+  CHECK(queue.present()->generation == newer->generation);
+  CHECK(queue.stats().dropped == 1);
+}
+
+TEST(a_frame_older_than_the_front_frame_is_dropped) {
+  queue_type queue;
+  queue.request({1});
+  auto older = queue.wait();
+  queue.request({2});
+  auto newer = queue.wait();
+
+  CHECK(queue.complete(*newer));
+  CHECK(queue.present()->generation == newer->generation);
+  CHECK(!queue.complete(*older));
+  CHECK(queue.present()->generation == newer->generation);
+}
+
+TEST(a_ready_frame_replaced_before_it_is_shown_is_dropped) {
+  queue_type queue;
+  queue.request({1});
+  auto first = queue.wait();
+  CHECK(queue.complete(*first));
+
+  queue.request({2});
+  auto second = queue.wait();
+  CHECK(queue.complete(*second));
+
+  CHECK(queue.present()->generation == second->generation);
+  CHECK(queue.stats().completed == 2);
+  CHECK(queue.stats().dropped == 1);
+}
+
+TEST(an_abandoned_job_gives_back_its_buffer) {
+  queue_type queue;
+  queue.request({1});
+  auto job = queue.wait();
+  CHECK(!queue.superseded(job->generation));
+
+  queue.request({2});
+  CHECK(queue.superseded(job->generation));
+  queue.abandon(*job);
+  CHECK(queue.stats().dropped == 1);
+  CHECK(!queue.present());
+
+  // every buffer is free again, so the next job can use the abandoned one
+  auto next = queue.wait();
+  CHECK(next->buffer == job->buffer);
+}
+
+TEST(stop_wakes_a_waiting_worker) {
+  queue_type queue;
+  std::atomic<bool> returned{};
+  std::thread worker([&] {
+    CHECK(!queue.wait());
+    returned = true;
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  CHECK(!returned);
+  queue.stop();
+  worker.join();
+
+  CHECK(returned);
+  CHECK(queue.stopped());
+  CHECK(queue.superseded(0));
+
+  // requests after stop are never handed out
+  queue.request({1});
+  CHECK(!queue.wait());
+}
+
+// a worker renders while the UI thread requests and presents frames; the buffer shown must never
+// be the one the worker is rendering into, and the frames shown must never go backwards
+TEST(the_front_buffer_is_never_handed_to_the_worker) {
+  queue_type queue;
+
+  // the buffer the worker is rendering into, or -1; it is cleared before the frame is completed,
+  // so a frame can only be presented once its buffer is no longer marked
+  std::atomic<int64_t> rendering{-1};
+
+  std::thread worker([&] {
+    while (auto job = queue.wait()) {
+      rendering = static_cast<int64_t>(job->buffer);
+      std::this_thread::yield();
+      rendering = -1;
+
+      if (job->generation % 7 == 0)
+        queue.abandon(*job);
+      else
+        queue.complete(*job);
+    }
+  });
+
+  uint64_t last_shown = 0;
+  bool backwards = false;
+  uint64_t collisions = 0;
+  uint64_t requests = 0;
+  uint64_t shown = 0;
+  while (shown < 2000) {
+    queue.request({static_cast<int32_t>(requests++)});
+    std::this_thread::yield();
+
+    if (auto frame = queue.present()) {
+      backwards |= frame->generation < last_shown;
+      shown += frame->generation != last_shown;
+      last_shown = frame->generation;
+
+      // "shows" the frame for a moment, while the worker keeps rendering
+      for (int check = 0; check < 4; ++check)
+        collisions += rendering.load() == static_cast<int64_t>(frame->buffer);
+    }
+  }
+
+  queue.stop();
+  worker.join();
+
+  CHECK(collisions == 0);
+  CHECK(!backwards);
+  auto stats = queue.stats();
+  CHECK(stats.requests == requests);
+  CHECK(stats.completed >= shown);
+}
+
+int main() {
+  return run_tests();
+}
@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <wndkit/details/shared_ring.hpp>
+#include "check.hpp"
+
+using namespace wndkit::tests;
+using wndkit::details::shared_ring;
+
+namespace {
+
+/*
+   A POSIX shared memory object mapped twice, so the producer and the consumer see the ring at
+   different addresses as two processes would.
+*/
+class shared_memory {
+public:
+  explicit shared_memory(size_t size) :
+    size_(size) {
+    auto name = "/wndkit_ring_test_" + std::to_string(getpid());
+    auto fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    CHECK(fd >= 0);
+    shm_unlink(name.c_str());
+    CHECK(ftruncate(fd, static_cast<off_t>(size)) == 0);
+
+    producer_ = map(fd);
+    consumer_ = map(fd);
+    close(fd);
+  }
+
+  ~shared_memory() {
+    munmap(producer_, size_);
+    munmap(consumer_, size_);
+  }
+
+  shared_memory(const shared_memory&) = delete;
+  shared_memory& operator=(const shared_memory&) = delete;
+
+  std::span<std::byte> producer() const {
+    return {static_cast<std::byte*>(producer_), size_};
+  }
+
+  std::span<std::byte> consumer() const {
+    return {static_cast<std::byte*>(consumer_), size_};
+  }
+
+private:
+  void* map(int fd) const {
+    auto view = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    CHECK(view != MAP_FAILED);
+    return view;
+  }
+
+  size_t size_;
+  void* producer_{};
+  void* consumer_{};
+};
+
+// a record of `size` bytes holding `sequence` followed by a pattern derived from it
+std::vector<std::byte> make_record(uint64_t sequence, size_t size) {
+  std::vector<std::byte> record(size);
+  std::memcpy(record.data(), &sequence, sizeof(sequence));
+  for (auto i = sizeof(sequence); i < size; ++i)
+    record[i] = static_cast<std::byte>(sequence + i);
+  return record;
+}
+
+bool holds_record(std::span<const std::byte> bytes, uint64_t sequence, size_t size) {
+  auto expected = make_record(sequence, size);
+  return bytes.size() == size && std::equal(bytes.begin(), bytes.end(), expected.begin());
+}
+
+}
+
+TEST(attach_rejects_memory_without_a_ring) {
+  std::vector<std::byte> memory(shared_ring::required_size(256));
+  CHECK(!shared_ring::attach(memory));
+  CHECK(!shared_ring::attach(std::span(memory).first(8)));
+
+  shared_ring::create(memory);
+  CHECK(shared_ring::attach(memory));
+  CHECK(!shared_ring::attach(std::span(memory).first(shared_ring::required_size(128))));
+}
+
+TEST(an_empty_ring_has_nothing_to_read) {
+  shared_memory memory(shared_ring::required_size(256));
+  auto producer = shared_ring::create(memory.producer());
+  auto consumer = shared_ring::attach(memory.consumer());
+  CHECK(consumer && consumer->capacity() == 256);
+
+  // a descriptor that was never committed is refused
+  CHECK(!consumer->read({0, 16, 16}));
+
+  auto reserved = producer.reserve(16);
+  CHECK(reserved && reserved->bytes.size() == 16);
+  CHECK(!consumer->read(reserved->desc));
+
+  auto desc = producer.commit(*reserved);
+  CHECK(consumer->read(desc));
+}
+
+TEST(a_full_ring_refuses_records_until_one_is_released) {
+  shared_memory memory(shared_ring::required_size(256));
+  auto producer = shared_ring::create(memory.producer());
+  auto consumer = *shared_ring::attach(memory.consumer());
+
+  CHECK(!producer.reserve(257));
+
+  std::vector<shared_ring::descriptor> written;
+  for (uint64_t sequence = 0; auto desc = producer.write(make_record(sequence, 60)); ++sequence)
+    written.push_back(*desc);
+
+  // 60 byte records take 64 bytes each
+  CHECK(written.size() == 4);
+  CHECK(!producer.reserve(1));
+
+  consumer.release(written[0]);
+  CHECK(producer.reserve(64));
+  CHECK(!producer.reserve(65));
+  for (uint64_t sequence = 1; sequence < written.size(); ++sequence)
+    CHECK(holds_record(*consumer.read(written[sequence]), sequence, 60));
+
+  consumer.release(written.back());
+  CHECK(producer.reserve(256));
+}
+
+TEST(records_never_wrap_around_the_end) {
+  shared_memory memory(shared_ring::required_size(256));
+  auto producer = shared_ring::create(memory.producer());
+  auto consumer = *shared_ring::attach(memory.consumer());
+
+  // two 96 byte records fit a lap, and the 64 byte tail after them is skipped
+  uint64_t skipped = 0;
+  uint64_t expected_offset = 0;
+  for (uint64_t sequence = 0; sequence < 1000; ++sequence) {
+    auto desc = producer.write(make_record(sequence, 96));
+    CHECK(desc.has_value());
+    if (!desc)
+      return;
+
+    skipped += desc->offset != expected_offset;
+    CHECK(desc->offset % 256 + 96 <= 256);
+
+    // a released record can not be read again
+    CHECK(holds_record(*consumer.read(*desc), sequence, 96));
+    consumer.release(*desc);
+    CHECK(!consumer.read(*desc));
+    expected_offset = desc->end;
+  }
+
+  CHECK(skipped > 0);
+  CHECK(expected_offset > 1000 * 96);
+}
+
+TEST(descriptors_from_another_process_are_validated) {
+  shared_memory memory(shared_ring::required_size(256));
+  auto producer = shared_ring::create(memory.producer());
+  auto consumer = *shared_ring::attach(memory.consumer());
+
+  auto desc = *producer.write(make_record(1, 32));
+  CHECK(!consumer.read({desc.offset, desc.size + 1, desc.end}));
+  CHECK(!consumer.read({desc.offset, desc.size, desc.end + 16}));
+  CHECK(!consumer.read({desc.end, 0, desc.offset}));
+  CHECK(consumer.read(desc));
+}
+
+// the producer passes descriptors to the consumer through a queue standing in for window messages;
+// the consumer must see every record, whole and in order, while the ring wraps around many times
+TEST(a_producer_and_consumer_thread_keep_records_in_order) {
+  shared_memory memory(shared_ring::required_size(4096));
+  auto producer = shared_ring::create(memory.producer());
+  auto consumer = *shared_ring::attach(memory.consumer());
+
+  constexpr uint64_t record_count = 100000;
+  auto record_size = [](uint64_t sequence) { return static_cast<size_t>(8 + sequence * 7 % 500); };
+
+  std::mutex mutex;
+  std::condition_variable ready;
+  std::deque<shared_ring::descriptor> messages;
+
+  std::thread producing([&] {
+    for (uint64_t sequence = 0; sequence < record_count; ++sequence) {
+      auto record = make_record(sequence, record_size(sequence));
+      std::optional<shared_ring::descriptor> desc;
+      while (!(desc = producer.write(record)))
+        std::this_thread::yield();
+
+      std::lock_guard lock(mutex);
+      messages.push_back(*desc);
+      ready.notify_one();
+    }
+  });
+
+  uint64_t received = 0;
+  uint64_t out_of_order = 0;
+  uint64_t last_offset = 0;
+  while (received < record_count) {
+    shared_ring::descriptor desc;
+    {
+      std::unique_lock lock(mutex);
+      ready.wait(lock, [&] { return !messages.empty(); });
+      desc = messages.front();
+      messages.pop_front();
+    }
+
+    auto bytes = consumer.read(desc);
+    out_of_order += !bytes || !holds_record(*bytes, received, record_size(received)) || desc.offset < last_offset;
+    last_offset = desc.end;
+    consumer.release(desc);
+    ++received;
+  }
+
+  producing.join();
+  CHECK(out_of_order == 0);
+}
+
+int main() {
+  return run_tests();
+}
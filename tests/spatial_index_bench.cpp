@@ -0,0 +1,71 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <wndkit/widgets/core/spatial_index.hpp>
+#include "check.hpp"
+#include "spatial_index_support.hpp"
+
+using namespace wndkit::tests;
+
+namespace {
+
+constexpr size_t rect_count = 100000;
+constexpr int32_t extent = 20000;
+
+}
+
+// indexes 100k rectangles, then compares point queries with a scan of every rectangle
+TEST(query_100k_rectangles) {
+  std::mt19937 random(1);
+  std::vector<core::rect> areas;
+  for (size_t i = 0; i < rect_count; ++i)
+    areas.push_back(random_rect(random, extent));
+
+  core::spatial_index index;
+  brute_force_index expected;
+  auto build_us = time_us(1, [&] {
+    for (size_t i = 0; i < rect_count; ++i)
+      index.set(i + 1, areas[i], static_cast<int32_t>(i % 5));
+  });
+  for (size_t i = 0; i < rect_count; ++i)
+    expected.set(i + 1, areas[i], static_cast<int32_t>(i % 5));
+
+  std::vector<std::pair<int32_t, int32_t>> points;
+  for (int i = 0; i < 100000; ++i)
+    points.emplace_back(std::uniform_int_distribution<int32_t>(-extent / 10, extent)(random), std::uniform_int_distribution<int32_t>(-extent / 10, extent)(random));
+
+  size_t next = 0;
+  size_t hits = 0;
+  auto query_us = time_us(static_cast<int>(points.size()), [&] {
+    auto [x, y] = points[next++];
+    hits += index.query(x, y).has_value();
+  });
+
+  next = 0;
+  auto scan_us = time_us(200, [&] {
+    auto [x, y] = points[next++];
+    hits += expected.query(x, y).has_value();
+  });
+
+  size_t mismatches = 0;
+  for (size_t i = 0; i < 2000; ++i) {
+    auto [x, y] = points[i];
+    mismatches += index.query(x, y) != expected.query(x, y);
+  }
+  CHECK(mismatches == 0);
+
+  // moving a rectangle relinks it in the cells it leaves and enters
+  next = 0;
+  auto move_us = time_us(10000, [&] {
+    auto key = next++ % rect_count;
+    auto area = areas[key];
+    index.set(key + 1, {area.left + 3, area.top + 3, area.right + 3, area.bottom + 3}, static_cast<int32_t>(key % 5));
+  });
+
+  std::printf("%zu rectangles: build %.0f us, query %.3f us (scan %.1f us), move %.3f us, %zu hits\n", rect_count, build_us, query_us, scan_us, move_us, hits);
+}
+
+int main() {
+  return run_tests();
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <unordered_map>
+#include <wndkit/widgets/core/spatial_index.hpp>
+
+namespace wndkit::tests {
+
+namespace core = wndkit::widgets::core;
+
+// the rectangles of a spatial index, searched one by one
+class brute_force_index {
+public:
+  struct entry {
+    core::rect area;
+    int32_t z{};
+  };
+
+  void set(core::spatial_index::key_type key, const core::rect& area, int32_t z = 0) {
+    entries_[key] = {area, z};
+  }
+
+  void remove(core::spatial_index::key_type key) {
+    entries_.erase(key);
+  }
+
+  // the topmost rectangle containing the point: the highest z, then the highest key
+  std::optional<core::spatial_index::key_type> query(int32_t x, int32_t y) const {
+    std::optional<core::spatial_index::key_type> top;
+    int32_t top_z = 0;
+    for (const auto& [key, entry] : entries_) {
+      const auto& area = entry.area;
+      if (x < area.left || x >= area.right || y < area.top || y >= area.bottom)
+        continue;
+
+      if (!top || entry.z > top_z || (entry.z == top_z && key > *top)) {
+        top = key;
+        top_z = entry.z;
+      }
+    }
+
+    return top;
+  }
+
+  const auto& entries() const {
+    return entries_;
+  }
+
+private:
+  std::unordered_map<core::spatial_index::key_type, entry> entries_;
+};
+
+// a rectangle within `extent`: mostly small, sometimes covering many cells, sometimes empty
+inline core::rect random_rect(std::mt19937& random, int32_t extent) {
+  auto pick = [&](int32_t low, int32_t high) { return std::uniform_int_distribution<int32_t>(low, high)(random); };
+
+  auto x = pick(-extent / 10, extent);
+  auto y = pick(-extent / 10, extent);
+  switch (pick(0, 19)) {
+  case 0:
+    return {x, y, x + pick(200, 1000), y + pick(200, 1000)};
+  case 1:
+    return {x, y, x, y + pick(0, 50)};
+  default:
+    return {x, y, x + pick(1, 120), y + pick(1, 40)};
+  }
+}
+
+}
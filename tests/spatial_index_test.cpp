@@ -0,0 +1,139 @@
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <wndkit/widgets/core/spatial_index.hpp>
+#include "check.hpp"
+#include "spatial_index_support.hpp"
+
+using namespace wndkit::tests;
+
+namespace {
+
+// queries a grid of points over `extent`, and the corners of every rectangle; returns the number that differ
+size_t count_mismatches(const core::spatial_index& index, const brute_force_index& expected, int32_t extent) {
+  size_t mismatches = 0;
+  auto compare = [&](int32_t x, int32_t y) {
+    if (index.query(x, y) != expected.query(x, y))
+      ++mismatches;
+  };
+
+  for (int32_t y = -extent / 10; y < extent + 200; y += 7) {
+    for (int32_t x = -extent / 10; x < extent + 200; x += 13)
+      compare(x, y);
+  }
+
+  for (const auto& [key, entry] : expected.entries()) {
+    const auto& area = entry.area;
+    compare(area.left, area.top);
+    compare(area.right - 1, area.bottom - 1);
+    compare(area.right, area.bottom);
+    compare(area.left - 1, area.top);
+  }
+
+  return mismatches;
+}
+
+}
+
+TEST(query_finds_the_topmost_rectangle) {
+  core::spatial_index index(32);
+  index.set(1, {0, 0, 100, 100});
+  index.set(2, {50, 50, 150, 150});
+  index.set(3, {60, 60, 70, 70}, -1);
+
+  CHECK(index.query(10, 10) == 1u);
+  CHECK(index.query(60, 60) == 2u);   // the later key wins among equal z
+  CHECK(index.query(149, 149) == 2u);
+  CHECK(!index.query(150, 150));      // right and bottom edges are outside
+
+  index.set(3, {60, 60, 70, 70}, 1);
+  CHECK(index.query(65, 65) == 3u);
+
+  index.remove(2);
+  CHECK(index.query(100, 100) == std::nullopt);
+  CHECK(index.query(60, 60) == 3u);
+}
+
+TEST(query_matches_a_brute_force_scan) {
+  constexpr int32_t extent = 2000;
+
+  for (uint32_t seed = 1; seed <= 5; ++seed) {
+    std::mt19937 random(seed);
+    auto pick = [&](int32_t low, int32_t high) { return std::uniform_int_distribution<int32_t>(low, high)(random); };
+
+    core::spatial_index index(seed * 16);
+    brute_force_index expected;
+    for (core::spatial_index::key_type key = 1; key <= 500; ++key) {
+      auto area = random_rect(random, extent);
+      auto z = pick(-2, 2);
+      index.set(key, area, z);
+      expected.set(key, area, z);
+    }
+    CHECK(index.size() == expected.entries().size());
+    CHECK(count_mismatches(index, expected, extent) == 0);
+
+    // move, restack and remove some rectangles
+    for (int i = 0; i < 300; ++i) {
+      core::spatial_index::key_type key = pick(1, 500);
+      if (pick(0, 3) == 0) {
+        index.remove(key);
+        expected.remove(key);
+      } else {
+        auto area = pick(0, 1) ? random_rect(random, extent) : expected.entries().count(key) ? expected.entries().at(key).area : core::rect{};
+        auto z = pick(-2, 2);
+        index.set(key, area, z);
+        expected.set(key, area, z);
+      }
+    }
+    CHECK(index.size() == expected.entries().size());
+    CHECK(count_mismatches(index, expected, extent) == 0);
+  }
+}
+
+// rectangles of every size, up to the whole coordinate range, go in coarser levels of the grid
+TEST(query_finds_rectangles_of_every_size) {
+  constexpr int32_t min = std::numeric_limits<int32_t>::min();
+  constexpr int32_t max = std::numeric_limits<int32_t>::max();
+
+  std::mt19937 random(7);
+  auto pick = [&](int32_t low, int32_t high) { return std::uniform_int_distribution<int32_t>(low, high)(random); };
+
+  core::spatial_index index(1);
+  brute_force_index expected;
+  auto set = [&](core::spatial_index::key_type key, const core::rect& area, int32_t z) {
+    index.set(key, area, z);
+    expected.set(key, area, z);
+  };
+
+  set(1, {min, min, max, max}, -5);
+  set(2, {-100000, -100000, 100000, 100000}, -4);
+  for (core::spatial_index::key_type key = 3; key < 400; ++key) {
+    auto x = pick(-3000, 3000);
+    auto y = pick(-3000, 3000);
+    auto size = 1 << pick(0, 13);
+    set(key, {x, y, x + size, y + pick(1, size)}, pick(-3, 3));
+  }
+  CHECK(count_mismatches(index, expected, 3000) == 0);
+
+  CHECK(index.query(min, min) == 1u);
+  CHECK(index.query(max - 1, max - 1) == 1u);
+  CHECK(index.query(-99999, 99999) == 2u);
+
+  // moving a rectangle between levels, and removing it, leaves nothing behind in the level it left
+  for (core::spatial_index::key_type key = 3; key < 400; key += 3) {
+    auto x = pick(-3000, 3000);
+    set(key, {x, x, x + (key % 2 ? 4 : 4000), x + 4}, 4);
+  }
+  CHECK(count_mismatches(index, expected, 3000) == 0);
+
+  for (core::spatial_index::key_type key = 1; key < 400; key += 2) {
+    index.remove(key);
+    expected.remove(key);
+  }
+  CHECK(count_mismatches(index, expected, 3000) == 0);
+  CHECK(!index.query(min, min));
+}
+
+int main() {
+  return run_tests();
+}